@@ -2,7 +2,10 @@
 
 #pragma once
 
+#include "Containers/CircularQueue.h"
 #include "Containers/Map.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "Sound/SoundAttenuation.h"
 #include "AudioDevice.h"
@@ -35,11 +38,18 @@ enum Type
 /** Used to store callback info from FMOD thread to our event */
 struct FTimelineMarkerProperties
 {
-    FString Name;
+    /** Longer marker names are truncated, so the FMOD thread never has to allocate */
+    static constexpr int32 MaxNameLength = 128;
+
+    ANSICHAR Name[MaxNameLength];
+    uint32 NameHash;
     int32 Position;
     FTimelineMarkerProperties()
-        : Position(0)
-    {}
+        : NameHash(0)
+        , Position(0)
+    {
+        Name[0] = 0;
+    }
 };
 
 /** Used to store callback info from FMOD thread to our event */
@@ -97,11 +107,25 @@ struct FFMODOcclusionDetails
     /** Whether or not to enable complex geometry occlusion checks. */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="FMOD|Occlusion", meta=(EditCondition = "bEnableOcclusion"))
     bool bUseComplexCollisionForOcclusion;
+    /** Set the occlusion parameter to the fraction of several jittered rays that are blocked, rather than 0 or 1 from a single ray. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FMOD|Occlusion", meta = (EditCondition = "bEnableOcclusion"))
+    bool bEnablePartialOcclusion;
+    /** Number of rays averaged for partial occlusion. One ray is cast per trace, so they are spread across frames. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FMOD|Occlusion",
+        meta = (ClampMin = "1", ClampMax = "64", UIMin = "1", UIMax = "64", EditCondition = "bEnableOcclusion && bEnablePartialOcclusion"))
+    int32 OcclusionRayCount;
+    /** Maximum distance each end of a partial occlusion ray is jittered from the emitter and listener. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FMOD|Occlusion",
+        meta = (ClampMin = "0.0", UIMin = "0.0", EditCondition = "bEnableOcclusion && bEnablePartialOcclusion"))
+    float OcclusionJitterRadius;
 
     FFMODOcclusionDetails()
         : bEnableOcclusion(false)
         , OcclusionTraceChannel(ECC_Visibility)
         , bUseComplexCollisionForOcclusion(false)
+        , bEnablePartialOcclusion(false)
+        , OcclusionRayCount(8)
+        , OcclusionJitterRadius(50.0f)
     {}
 };
 
@@ -140,6 +164,8 @@ class FMODSTUDIO_API UFMODAudioComponent : public USceneComponent
 
     friend struct FFMODEventControlExecutionToken;
     friend struct FPlayingToken;
+    friend class FFMODOcclusionScheduler;
+    friend class FFMODEmitterManager;
     friend FMOD_RESULT F_CALLBACK UFMODAudioComponent_EventCallback(FMOD_STUDIO_EVENT_CALLBACK_TYPE type, FMOD_STUDIO_EVENTINSTANCE *event, void *parameters);
 
 public:
@@ -232,6 +258,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Audio|FMOD|Components")
     void SetParameter(FName Name, float Value);
 
+    /** Set several parameters of the Event at once. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|FMOD|Components")
+    void SetParameters(const TMap<FName, float> &Parameters);
+
     /** Will be deprecated in FMOD 2.01, use `GetParameterValue(FName, float, float)` instead.
      * Get parameter value from the Event.
     */
@@ -344,6 +374,37 @@ private:
     /** Update attenuation if we have it set. */
     void UpdateAttenuation();
 
+    /**
+     * Apply the result of an occlusion trace made by the occlusion scheduler.
+     * Returns whether another ray is needed to complete a partial occlusion update.
+     */
+    bool ApplyOcclusion(bool bIsOccluded);
+
+    /** Push the 3D attributes and update interior volumes, attenuation and occlusion. */
+    void UpdateSpatialState();
+
+    /** Update interior volumes, attenuation and occlusion. */
+    void UpdateVolumes();
+
+    /**
+     * Returns whether a spatial update should wait because the last one was less than the update interval of the
+     * component's distance band ago. The update is then made by a later TickEmitter.
+     */
+    bool DeferSpatialUpdate();
+
+    /**
+     * Returns whether UpdateVolumes should wait because the instance is virtual and the last one was less than
+     * UFMODSettings::VirtualEmitterUpdateInterval ago. The 3D attributes are still pushed, so FMOD can make the instance
+     * real as soon as it becomes audible.
+     */
+    bool DeferVolumeUpdate();
+
+    /** Find the UFMODSettings::UpdateBands band for the distance to the nearest listener, and apply its tick interval. */
+    void UpdateDistanceBand(const FVector &Location);
+
+    /** Request an occlusion trace, or leave it pending if the distance band's occlusion interval hasn't passed. */
+    void RequestOcclusion();
+
     /** Apply Volume and LPF into event. */
     void ApplyVolumeLPF();
 
@@ -363,7 +424,7 @@ private:
     void OnPlaybackCompleted();
 
     void EventCallbackSoundStopped();
-    bool TriggerSoundStoppedDelegate;
+    FThreadSafeBool TriggerSoundStoppedDelegate;
 
 // Begin ActorComponent interface.
     /** Called when a component is registered, after Scene is set, but before CreateRenderState_Concurrent or OnCreatePhysicsState are called. */
@@ -382,6 +443,9 @@ private:
     virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
 // End ActorComponent interface.
 
+    /** Per-frame update of a playing event, from TickComponent or the emitter manager. */
+    void TickEmitter();
+
 #if WITH_EDITORONLY_DATA
     void UpdateSpriteTexture();
 #endif
@@ -400,6 +464,12 @@ private:
     /** Check if a parameter is game controlled or automated to determine if it should be cached. */
     bool ShouldCacheParameter(const FMOD_STUDIO_PARAMETER_DESCRIPTION& ParameterDescription);
 
+    /** Set parameters on the Studio Instance, by id where known. */
+    void ApplyParameters(const TMap<FName, float> &Parameters);
+
+    /** Parameter ids of the Event the Studio Instance was created from. */
+    TSharedPtr<const FFMODParameterIds> ParameterIds;
+
     /** Return a cached reference to the current IFMODStudioModule.*/
     IFMODStudioModule& GetStudioModule()
     {
@@ -431,8 +501,49 @@ private:
     float LastVolume;
     /** Previously set LPF value. Used for automating volume and/or LPF with Ambient Zones. */
     float LastLPF;
+    /** The audio volume containing the component when it was last looked up, if any. */
+    TWeakObjectPtr<class AAudioVolume> CachedAudioVolume;
+    /** The interior settings of CachedAudioVolume, or of the world if it is null. */
+    const struct FInteriorSettings *CachedInteriorSettings;
+    /** Where the component was when the audio volume was last looked up. */
+    FVector CachedAudioVolumeLocation;
+    /** IFMODStudioModule::GetAudioVolumeGeneration when the audio volume was last looked up. */
+    uint32 CachedAudioVolumeGeneration;
     /** Was the object occluded in the previous frame. */
     bool wasOccluded;
+    /** Whether the Studio Instance is virtual, set from the Studio update thread by virtualization callbacks. */
+    FThreadSafeBool bIsVirtual;
+    /** bIsVirtual as of the last TickEmitter, to catch the instance becoming real. */
+    bool bWasVirtual;
+    /** Whether a spatial update was deferred by DeferSpatialUpdate. */
+    bool bSpatialUpdatePending;
+    /** Copy of UFMODSettings::VirtualEmitterUpdateInterval taken when playing. */
+    float VirtualUpdateInterval;
+    /** Time of the last spatial update. */
+    double LastSpatialUpdateTime;
+    /** Whether an update of interior volumes, attenuation and occlusion was deferred by DeferVolumeUpdate. */
+    bool bVolumeUpdatePending;
+    /** Time of the last UpdateVolumes. */
+    double LastVolumeUpdateTime;
+    /** Index of the current distance band in UFMODSettings::UpdateBands, or INDEX_NONE for full rate updates. */
+    int32 DistanceBandIndex;
+    /** Spatial update interval of the current distance band. */
+    float UpdateBandInterval;
+    /** Occlusion interval of the current distance band. */
+    float OcclusionBandInterval;
+    /** Location and time of the last 3D attributes pushed to the Studio Instance. */
+    FVector LastAttributesLocation;
+    double LastAttributesTime;
+    /** Time occlusion was last requested from the occlusion scheduler. */
+    double LastOcclusionRequestTime;
+    /** Whether an occlusion request is waiting for the occlusion interval to pass. */
+    bool bOcclusionRequestPending;
+    /** Smoothed fraction of partial occlusion rays that were blocked. */
+    float PartialOcclusion;
+    /** Partial occlusion rays still to cast since the emitter or listener last moved. */
+    int32 PartialOcclusionRaysRemaining;
+    /** Whether PartialOcclusion has had its first ray. */
+    bool bPartialOcclusionPrimed;
     /** Stored ID of the Occlusion parameter of the Event (if applicable). */
     FMOD_STUDIO_PARAMETER_ID OcclusionID;
     /** Stored ID of the Volume parameter of the Event (if applicable). */
@@ -443,10 +554,14 @@ private:
     // Tempo and marker callbacks.
     /** A scope lock used specifically for callbacks. */
     FCriticalSection CallbackLock;
-    /** Stores the Timeline Markers as they are triggered. */
-    TArray<FTimelineMarkerProperties> CallbackMarkerQueue;
-    /** Stores the Timeline Beats as they are triggered. */
-    TArray<FTimelineBeatProperties> CallbackBeatQueue;
+    /** Timeline Markers as they are triggered, written by the FMOD thread and read by the game thread. Created on first play. */
+    TUniquePtr<TCircularQueue<FTimelineMarkerProperties>> CallbackMarkerQueue;
+    /** Timeline Beats as they are triggered, written by the FMOD thread and read by the game thread. Created on first play. */
+    TUniquePtr<TCircularQueue<FTimelineBeatProperties>> CallbackBeatQueue;
+    /** Number of markers and beats dropped because the game thread hadn't emptied the queues in time. */
+    FThreadSafeCounter DroppedTimelineCallbacks;
+    /** Marker names by hash, so each name is only converted to an FString once. */
+    TMap<uint32, FString> MarkerNames;
 
     /** Direct assignment of programmer sound from other C++ code. */
     FMOD::Sound *ProgrammerSound;
@@ -456,4 +571,10 @@ private:
 
     /** Used by FPlayingToken to prevent restarting from delayed sequencer state restore. */
     bool bPlayEnded;
+
+    /** Slot in the emitter manager while it is updating this component instead of TickComponent, otherwise INDEX_NONE. */
+    int32 EmitterIndex;
+
+    /** Time the emitter manager last updated this component, so it keeps to UpdateBandInterval as the tick function does. */
+    double LastEmitterUpdateTime;
 };
\ No newline at end of file
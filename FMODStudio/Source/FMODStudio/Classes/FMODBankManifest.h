@@ -0,0 +1,28 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "FMODBankManifest.generated.h"
+
+class UFMODBank;
+
+/**
+ * A set of banks needed by a level, data layer or anything else that comes and goes at runtime.
+ * Banks are reference counted across all manifests in use, see UFMODBankManifestComponent.
+ */
+UCLASS(BlueprintType)
+class FMODSTUDIO_API UFMODBankManifest : public UDataAsset
+{
+    GENERATED_UCLASS_BODY()
+
+public:
+    /** Banks to load while this manifest is in use. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = FMOD)
+    TArray<UFMODBank *> Banks;
+
+    /** Whether to also load the sample data of the banks while this manifest is in use. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = FMOD)
+    bool bLoadSampleData;
+};
@@ -0,0 +1,33 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "FMODBankManifestComponent.generated.h"
+
+class UFMODBankManifest;
+
+/**
+ * Keeps the banks of a manifest loaded while the owning actor is in play. Place one in a streaming level or data layer to
+ * load its banks when it streams in and unload them when it streams out.
+ */
+UCLASS(ClassGroup = (Audio, Common), hidecategories = (Object, ActorComponent), meta = (BlueprintSpawnableComponent))
+class FMODSTUDIO_API UFMODBankManifestComponent : public UActorComponent
+{
+    GENERATED_UCLASS_BODY()
+
+public:
+    /** The banks to keep loaded. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = FMOD)
+    UFMODBankManifest *Manifest;
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+    /** The manifest acquired in BeginPlay, released in EndPlay. */
+    UPROPERTY(Transient)
+    UFMODBankManifest *AcquiredManifest;
+};
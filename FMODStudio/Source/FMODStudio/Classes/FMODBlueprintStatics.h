@@ -134,6 +134,18 @@ class FMODSTUDIO_API UFMODBlueprintStatics : public UBlueprintFunctionLibrary
         meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", UnsafeDuringActorConstruction = "true"))
     static void UnloadEventSampleData(UObject *WorldContextObject, UFMODEvent *Event);
 
+    /** Load programmer sounds in the background so they are ready when their dialogue plays.
+	 * @param Names - audio table keys, or file paths relative to the content directory.
+	 */
+    UFUNCTION(BlueprintCallable, Category = "Audio|FMOD", meta = (UnsafeDuringActorConstruction = "true"))
+    static void PreloadProgrammerSounds(const TArray<FString> &Names);
+
+    /** Allow preloaded programmer sounds to be released once they are no longer playing.
+	 * @param Names - names passed to Preload Programmer Sounds.
+	 */
+    UFUNCTION(BlueprintCallable, Category = "Audio|FMOD", meta = (UnsafeDuringActorConstruction = "true"))
+    static void UnloadProgrammerSounds(const TArray<FString> &Names);
+
     /** Return a list of all event instances that are playing for this event.
 		Be careful using this function because it is possible to find and alter any playing sound, even ones owned by other audio components.
 	 * @param Event - event to find instances from.
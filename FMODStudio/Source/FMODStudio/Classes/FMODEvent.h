@@ -3,10 +3,24 @@
 #pragma once
 
 #include "FMODAsset.h"
+#include "FMODStudioModule.h"
 #include "FMODEvent.generated.h"
 
 struct FMOD_STUDIO_PARAMETER_DESCRIPTION;
 
+/** An event description looked up in one Studio system, valid while the system's bank generation is unchanged */
+struct FFMODCachedEventDescription
+{
+    FFMODCachedEventDescription()
+        : Description(nullptr)
+        , Generation(0)
+    {
+    }
+
+    FMOD::Studio::EventDescription *Description;
+    uint32 Generation;
+};
+
 /**
  * FMOD Event Asset.
  */
@@ -20,6 +34,11 @@ public:
     void GetParameterDescriptions(TArray<FMOD_STUDIO_PARAMETER_DESCRIPTION> &Parameters) const;
 
 private:
+    friend class FFMODStudioModule;
+
+    /** Event descriptions cached by IFMODStudioModule::GetEventDescription, for each system context */
+    mutable FFMODCachedEventDescription CachedDescriptions[EFMODSystemContext::Max];
+
     /** Get tags to show in content view */
     virtual void GetAssetRegistryTags(TArray<FAssetRegistryTag> &OutTags) const override;
 
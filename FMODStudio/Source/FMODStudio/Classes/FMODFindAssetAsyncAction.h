@@ -0,0 +1,41 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "FMODFindAssetAsyncAction.generated.h"
+
+class UFMODAsset;
+struct FStreamableHandle;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FFMODFindAssetAsyncActionFound, UFMODAsset *, Asset);
+
+/**
+ * Latent node finding an FMOD asset by name without blocking the game thread.
+ */
+UCLASS()
+class FMODSTUDIO_API UFMODFindAssetAsyncAction : public UBlueprintAsyncActionBase
+{
+    GENERATED_UCLASS_BODY()
+
+public:
+    /** Find an asset by name, loading it in the background if needed.
+	 * @param Name - The asset name
+	 */
+    UFUNCTION(BlueprintCallable, Category = "Audio|FMOD", meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"))
+    static UFMODFindAssetAsyncAction *FindAssetByNameAsync(UObject *WorldContextObject, const FString &Name);
+
+    /** Called with the asset once found, or with none if there is no asset with the name. */
+    UPROPERTY(BlueprintAssignable)
+    FFMODFindAssetAsyncActionFound OnFound;
+
+    //~ UBlueprintAsyncActionBase
+    virtual void Activate() override;
+
+private:
+    void HandleFound(UFMODAsset *Asset);
+
+    FString Name;
+    TSharedPtr<FStreamableHandle> Handle;
+};
@@ -174,6 +174,32 @@ struct FFMODPlatformSettings
     {}
 };
 
+USTRUCT()
+struct FFMODUpdateBand
+{
+    GENERATED_USTRUCT_BODY()
+    /**
+    * Distance from the nearest listener at which this band begins.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Basic, meta = (ClampMin = "0.0", UIMin = "0.0"))
+    float Distance;
+    /**
+    * Seconds between ticks and spatial updates (3D attributes, interior volumes and attenuation), or 0 for every frame.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Basic, meta = (ClampMin = "0.0", UIMin = "0.0"))
+    float UpdateInterval;
+    /**
+    * Minimum seconds between occlusion traces, or 0 to trace on every spatial update.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Basic, meta = (ClampMin = "0.0", UIMin = "0.0"))
+    float OcclusionInterval;
+    FFMODUpdateBand()
+        : Distance(0.0f)
+        , UpdateInterval(0.0f)
+        , OcclusionInterval(0.0f)
+    {}
+};
+
 USTRUCT()
 struct FFMODProjectLocale
 {
@@ -223,6 +249,98 @@ public:
     UPROPERTY(config, EditAnywhere, Category = Basic)
     bool bLoadAllSampleData;
 
+    /**
+     * Whether to load banks at startup without blocking. Progress is reported through IFMODStudioModule::BankLoadProgressEvent
+     * and IFMODStudioModule::BanksLoadedEvent, and buses are locked once the master bank has loaded.
+     */
+    UPROPERTY(config, EditAnywhere, Category = Basic)
+    bool bLoadBanksAsynchronously;
+
+    /**
+     * Maximum bytes of event sample data to keep loaded through Load Event Sample Data, or 0 for no limit (the default).
+     * The least recently used events are unloaded when the budget is exceeded. Events that are playing are never unloaded.
+     * Sample data can only be measured when FMOD allocates through Unreal, which it does in the editor and when the
+     * platform's Memory Pool Size is 0, or in logging builds with Memory Tracking enabled. Otherwise the budget is
+     * disabled with a warning. Event sizes are estimates, as sample data loaded by other means while an event loads is
+     * counted towards it.
+     */
+    UPROPERTY(config, EditAnywhere, Category = Basic, meta = (ClampMin = "0"))
+    int32 SampleDataBudget;
+
+    /**
+     * Distance from a listener at which FMOD Audio Components load the sample data of their event ahead of playing it,
+     * or 0 to disable prefetching (the default). Prefetched sample data counts towards the Sample Data Budget.
+     */
+    UPROPERTY(config, EditAnywhere, Category = Basic, meta = (ClampMin = "0.0", UIMin = "0.0"))
+    float SampleDataPrefetchRadius;
+
+    /**
+     * Distance beyond the prefetch radius a component must move before its prefetched sample data is released.
+     */
+    UPROPERTY(config, EditAnywhere, Category = Basic, meta = (ClampMin = "0.0", UIMin = "0.0", EditCondition = "SampleDataPrefetchRadius > 0"))
+    float SampleDataPrefetchHysteresis;
+
+    /**
+     * Maximum number of asynchronous occlusion traces issued each frame, or 0 for no limit. When more FMOD Audio Components
+     * need an occlusion update the most audible are traced first and the rest wait for a later frame.
+     */
+    UPROPERTY(config, EditAnywhere, Category = Basic, meta = (ClampMin = "0"))
+    int32 OcclusionTracesPerFrame;
+
+    /**
+     * Update playing FMOD Audio Components in game worlds from a single tick in the FMOD module, rather than from a tick
+     * function per component. This reduces tick dispatch overhead when many components are playing.
+     */
+    UPROPERTY(config, EditAnywhere, Category = Basic)
+    bool bUseEmitterManager;
+
+    /**
+     * Distance an FMOD Audio Component must move before the audio volume containing it is looked up again, or 0 to look it
+     * up on every update. Stationary components then reuse the volume they were in.
+     */
+    UPROPERTY(config, EditAnywhere, Category = Basic, meta = (ClampMin = "0.0", UIMin = "0.0"))
+    float AudioVolumeQueryDistance;
+
+    /**
+     * Minimum time in seconds between interior volume and attenuation updates of FMOD Audio Components whose event instance
+     * is virtual, or 0 to update them at the full rate. 3D attributes are always updated, so a virtual instance becomes real
+     * as soon as it is audible. Virtual instances are not traced for occlusion. Full-rate updates resume when they become real.
+     */
+    UPROPERTY(config, EditAnywhere, Category = Basic, meta = (ClampMin = "0.0", UIMin = "0.0"))
+    float VirtualEmitterUpdateInterval;
+
+    /**
+     * Update rates of FMOD Audio Components by distance from the nearest listener. Each component uses the band with the
+     * greatest distance it is beyond, e.g. 0 at every frame, 2000 at 0.1 seconds and 5000 at 0.5 seconds. Components nearer
+     * than every band, or all components if there are no bands (the default), update every frame.
+     */
+    UPROPERTY(config, EditAnywhere, Category = Basic)
+    TArray<FFMODUpdateBand> UpdateBands;
+
+    /**
+     * Maximum number of stopped instances of each event to keep for reuse by FMOD Audio Components, or 0 to create and
+     * release instances as needed (the default). Parameters and properties are reset before instances are reused. Idle
+     * instances keep their event's sample data loaded, so they are released when the Sample Data Budget unloads it.
+     */
+    UPROPERTY(config, EditAnywhere, Category = Basic, meta = (ClampMin = "0"))
+    int32 EventInstancePoolSize;
+
+    /**
+     * Number of instances to create up front the first time an event is played when pooling, up to the Event Instance Pool
+     * Size, or 0 to only pool instances once they have been played (the default). Each one is created on the game thread
+     * and loads the event's sample data.
+     */
+    UPROPERTY(config, EditAnywhere, Category = Basic, meta = (ClampMin = "0", EditCondition = "EventInstancePoolSize > 0"))
+    int32 EventInstancePoolWarmSize;
+
+    /**
+     * Maximum bytes of programmer sounds to keep loaded once they stop playing, so replaying the same audio table entry or
+     * file doesn't create its sound again, or 0 to release them as soon as they stop (the default). The least recently
+     * used sounds are released first. Sounds that stream are never kept.
+     */
+    UPROPERTY(config, EditAnywhere, Category = Basic, meta = (ClampMin = "0"))
+    int32 ProgrammerSoundCacheBudget;
+
     /**
      * Enable live update in non-final builds.
      */
@@ -308,6 +426,47 @@ public:
     UPROPERTY(config, EditAnywhere, Category = InitSettings)
     int32 FileBufferSize;
 
+    /**
+     * Number of threads servicing FMOD file reads (2 by default).
+     * One additional thread is always reserved for high priority reads such as streams.
+     */
+    UPROPERTY(config, EditAnywhere, Category = InitSettings, meta = (ClampMin = "1"))
+    int32 FileThreadCount;
+
+    /**
+     * Memory map bank files where the platform supports it (loose files on disk and uncompressed pak entries).
+     * Reads are then copied straight from the mapping instead of going through a file reader.
+     */
+    UPROPERTY(config, EditAnywhere, Category = InitSettings)
+    bool bMemoryMapBankFiles;
+
+    /**
+     * Read bank files through the platform's asynchronous read handles instead of blocking file readers.
+     * Reads are then prioritized by the engine alongside its own streaming, with FMOD stream reads issued at high priority.
+     */
+    UPROPERTY(config, EditAnywhere, Category = InitSettings)
+    bool bUseAsyncFileReadHandles;
+
+    /**
+     * Size in bytes of the block cache shared by all FMOD file reads, or 0 to disable it (the default).
+     * Streams reading the same bank share cached blocks.
+     */
+    UPROPERTY(config, EditAnywhere, Category = InitSettings, meta = (ClampMin = "0"))
+    int32 FileCacheSize;
+
+    /**
+     * Size in bytes of each block in the file cache (64KB by default). Rounded up to a power of two of at least 4KB.
+     */
+    UPROPERTY(config, EditAnywhere, Category = InitSettings, meta = (ClampMin = "4096"))
+    int32 FileCacheBlockSize;
+
+    /**
+     * Number of blocks to read ahead of files being read sequentially, such as streams (2 by default).
+     * Only used when the file cache is enabled.
+     */
+    UPROPERTY(config, EditAnywhere, Category = InitSettings, meta = (ClampMin = "0"))
+    int32 FileReadAheadBlocks;
+
     /**
      * Studio update period in milliseconds, or 0 for default (which means 20ms).
      */
@@ -44,6 +44,7 @@ namespace UnrealBuildTool.Rules
             PrivateDependencyModuleNames.AddRange(
                 new string[]
                 {
+                    "Json",
                     "MovieScene",
                     "MovieSceneTracks"
                 }
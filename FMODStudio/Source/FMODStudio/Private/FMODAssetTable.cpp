@@ -22,7 +22,8 @@
 FFMODAssetTable::FFMODAssetTable()
     : ActiveLocale(FString()),
       BankLookup(nullptr),
-      AssetLookup(nullptr)
+      AssetLookup(nullptr),
+      ActiveBankPaths(nullptr)
 {
 }
 
@@ -71,6 +72,8 @@ void FFMODAssetTable::Load()
         }
     }
 
+    BuildBankIndex();
+
     PackageName = PackagePath + AssetLookupName();
     Package = CreatePackage(*PackageName);
     Package->FullyLoad();
@@ -95,39 +98,111 @@ void FFMODAssetTable::Load()
             UE_LOG(LogFMOD, Error, msg);
         }
     }
+
+    BuildAssetIndex();
 }
 
-FString FFMODAssetTable::GetBankPathByGuid(const FGuid& Guid) const
+void FFMODAssetTable::BuildAssetIndex()
 {
-    FString BankPath;
+    AssetPaths.Reset();
+
+    if (!AssetLookup)
+    {
+        return;
+    }
+
+    AssetLookup->ForeachRow<FFMODAssetLookupRow>(nullptr, [this](const FName &RowName, const FFMODAssetLookupRow &Row) {
+        AssetPaths.Add(RowName.ToString(), FSoftObjectPath(Row.PackageName + TEXT(".") + Row.AssetName));
+    });
+}
+
+void FFMODAssetTable::BuildBankIndex()
+{
+    BankIndices.Reset();
+    BankTables.Reset();
+    LocaleBankPaths.Reset();
+    ActiveBankPaths = nullptr;
+
+    if (!BankLookup || !BankLookup->DataTable)
+    {
+        return;
+    }
+
+    // Rows are named after the bank guid, so parse them once here rather than formatting a name for every lookup
+    BankLookup->DataTable->ForeachRow<FFMODLocalizedBankTable>(nullptr, [this](const FName &RowName, const FFMODLocalizedBankTable &Row) {
+        FGuid Guid;
+        if (Row.Banks && FGuid::Parse(RowName.ToString(), Guid))
+        {
+            BankIndices.Add(Guid, BankTables.Add(Row.Banks));
+        }
+    });
+
+    ResolveLocaleBankPaths();
+}
 
+void FFMODAssetTable::ResolveLocaleBankPaths()
+{
     if (!BankLookup)
     {
-        UE_LOG(LogFMOD, Error, TEXT("Bank lookup not loaded"));
-        return BankPath;
+        return;
+    }
+
+    FLocaleBankPaths *Paths = LocaleBankPaths.Find(ActiveLocale);
+    if (!Paths)
+    {
+        const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+        const FString FullBankPath = Settings.GetFullBankPath();
+        const FString MasterBankFilenames[] = { Settings.GetMasterBankFilename(), Settings.GetMasterAssetsBankFilename(), Settings.GetMasterStringsBankFilename() };
+
+        Paths = &LocaleBankPaths.Add(ActiveLocale);
+        Paths->BankPaths.Reserve(BankTables.Num());
+        for (const UDataTable *BankTable : BankTables)
+        {
+            FString BankPath = GetLocalizedBankPath(BankTable);
+            Paths->BankPaths.Add(BankPath);
+
+            if (BankPath.IsEmpty())
+            {
+                // Never expect to be in here, but should skip empty paths
+                continue;
+            }
+
+            FString FullPath = FullBankPath / BankPath;
+            Paths->AllBankPaths.Add(FullPath);
+
+            bool bMasterBank = (BankPath == MasterBankFilenames[0] || BankPath == MasterBankFilenames[1] || BankPath == MasterBankFilenames[2]);
+            if (!bMasterBank)
+            {
+                Paths->NonMasterBankPaths.Add(MoveTemp(FullPath));
+            }
+        }
     }
 
-    FString GUID = Guid.ToString(EGuidFormats::DigitsWithHyphensInBraces);
-    FName BankTableName(*GUID);
-    FFMODLocalizedBankTable *BankTable = BankLookup->DataTable->FindRow<FFMODLocalizedBankTable>(BankTableName, nullptr, false);
+    ActiveBankPaths = Paths;
+}
 
-    if (BankTable)
+FString FFMODAssetTable::GetBankPathByGuid(const FGuid& Guid) const
+{
+    if (!ActiveBankPaths)
     {
-        BankPath = GetLocalizedBankPath(BankTable->Banks);
+        UE_LOG(LogFMOD, Error, TEXT("Bank lookup not loaded"));
+        return FString();
     }
-    
-    return BankPath;
+
+    const int32 *Index = BankIndices.Find(Guid);
+    return Index ? ActiveBankPaths->BankPaths[*Index] : FString();
 }
 
 FString FFMODAssetTable::GetLocalizedBankPath(const UDataTable* BankTable) const
 {
+    static const FName NonLocalizedRowName("<NON-LOCALIZED>");
+
     FName RowName(*ActiveLocale);
     FFMODLocalizedBankRow *Row = BankTable->FindRow<FFMODLocalizedBankRow>(RowName, nullptr, false);
 
     if (!Row)
     {
-        RowName = FName("<NON-LOCALIZED>");
-        Row = BankTable->FindRow<FFMODLocalizedBankRow>(RowName, nullptr, false);
+        Row = BankTable->FindRow<FFMODLocalizedBankRow>(NonLocalizedRowName, nullptr, false);
     }
 
     FString BankPath;
@@ -170,6 +245,7 @@ FString FFMODAssetTable::GetMasterAssetsBankPath() const
 void FFMODAssetTable::SetLocale(const FString &LocaleCode)
 {
     ActiveLocale = LocaleCode;
+    ResolveLocaleBankPaths();
 }
 
 FString FFMODAssetTable::GetLocale() const
@@ -179,30 +255,9 @@ FString FFMODAssetTable::GetLocale() const
 
 void FFMODAssetTable::GetAllBankPaths(TArray<FString> &Paths, bool IncludeMasterBank) const
 {
-    if (BankLookup)
+    if (ActiveBankPaths)
     {
-        const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
-
-        BankLookup->DataTable->ForeachRow<FFMODLocalizedBankTable>(nullptr, [this, &Paths, IncludeMasterBank, &Settings](const FName &, const FFMODLocalizedBankTable& OuterRow) {
-            FString BankPath = GetLocalizedBankPath(OuterRow.Banks);
-            bool Skip = false;
-
-            if (BankPath.IsEmpty())
-            {
-                // Never expect to be in here, but should skip empty paths
-                return;
-            }
-
-            if (!IncludeMasterBank)
-            {
-                Skip = (BankPath == Settings.GetMasterBankFilename() || BankPath == Settings.GetMasterAssetsBankFilename() || BankPath == Settings.GetMasterStringsBankFilename());
-            }
-
-            if (!Skip)
-            {
-                Paths.Push(Settings.GetFullBankPath() / BankPath);
-            }
-        });
+        Paths.Append(IncludeMasterBank ? ActiveBankPaths->AllBankPaths : ActiveBankPaths->NonMasterBankPaths);
     }
     else
     {
@@ -214,18 +269,23 @@ UFMODAsset *FFMODAssetTable::GetAssetByStudioPath(const FString &InStudioPath) c
 {
     UFMODAsset *Asset = nullptr;
 
-    if (AssetLookup)
+    const FSoftObjectPath *AssetPath = AssetPaths.Find(InStudioPath);
+    if (AssetPath)
     {
-        FFMODAssetLookupRow *Row = AssetLookup->FindRow<FFMODAssetLookupRow>(FName(*InStudioPath), nullptr);
-
-        if (Row)
+        // Assets that are already loaded are found without touching their package
+        UObject *Object = AssetPath->ResolveObject();
+        if (!Object)
         {
-            UPackage *Package = CreatePackage(*(Row->PackageName));
-            Package->FullyLoad();
-            Asset = FindObject<UFMODAsset>(Package, *(Row->AssetName));
+            Object = AssetPath->TryLoad();
         }
-
+        Asset = Cast<UFMODAsset>(Object);
     }
 
     return Asset;
 }
+
+FSoftObjectPath FFMODAssetTable::GetAssetPathByStudioPath(const FString &InStudioPath) const
+{
+    const FSoftObjectPath *AssetPath = AssetPaths.Find(InStudioPath);
+    return AssetPath ? *AssetPath : FSoftObjectPath();
+}
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "UObject/GCObject.h"
+#include "UObject/SoftObjectPath.h"
 
 class UDataTable;
 class UFMODAsset;
@@ -29,15 +30,50 @@ public:
 
     UFMODAsset *GetAssetByStudioPath(const FString &InStudioPath) const;
 
+    /** Returns the object path of the asset for a Studio path, without loading it */
+    FSoftObjectPath GetAssetPathByStudioPath(const FString &InStudioPath) const;
+
     static inline FString PrivateDataPath() { return FString(TEXT("PrivateIntegrationData/")); }
     static inline FString BankLookupName()  { return FString(TEXT("BankLookup")); }
     static inline FString AssetLookupName() { return FString(TEXT("AssetLookup")); }
 
 private:
+    /** Bank paths resolved for one locale, indexed like BankTables */
+    struct FLocaleBankPaths
+    {
+        /** Paths relative to the bank output directory */
+        TArray<FString> BankPaths;
+
+        /** Full paths of all banks, with and without the master banks */
+        TArray<FString> AllBankPaths;
+        TArray<FString> NonMasterBankPaths;
+    };
+
     FString GetBankPathByGuid(const FGuid& Guid) const;
     FString GetLocalizedBankPath(const UDataTable* BankTable) const;
 
+    /** Compiles the bank lookup into BankIndices and BankTables, discarding resolved paths */
+    void BuildBankIndex();
+
+    /** Compiles the asset lookup into AssetPaths */
+    void BuildAssetIndex();
+
+    /** Resolves bank paths for the active locale, reusing those of a previously active locale */
+    void ResolveLocaleBankPaths();
+
     FString ActiveLocale;
     UFMODBankLookup *BankLookup;
     UDataTable *AssetLookup;
+
+    /** Index into BankTables for each bank guid */
+    TMap<FGuid, int32> BankIndices;
+
+    /** The localized bank table of each bank, in lookup order */
+    TArray<const UDataTable *> BankTables;
+
+    TMap<FString, FLocaleBankPaths> LocaleBankPaths;
+    const FLocaleBankPaths *ActiveBankPaths;
+
+    /** Object path of each asset, by Studio path */
+    TMap<FString, FSoftObjectPath> AssetPaths;
 };
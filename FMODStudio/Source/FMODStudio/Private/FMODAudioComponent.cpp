@@ -8,14 +8,17 @@
 #include "FMODSettings.h"
 #include "fmod_studio.hpp"
 #include "Misc/App.h"
-#include "Misc/Paths.h"
 #include "Misc/ScopeLock.h"
+#include "Sound/AudioVolume.h"
 #include "FMODStudioPrivatePCH.h"
 #include "Components/BillboardComponent.h"
 #if WITH_EDITORONLY_DATA
 #include "Engine/Texture2D.h"
 #endif
 
+// Capacity of the timeline marker and beat queues, enough for several frames of a fast tempo
+static const uint32 TimelineCallbackQueueSize = 64;
+
 UFMODAudioComponent::UFMODAudioComponent(const FObjectInitializer &ObjectInitializer)
     : Super(ObjectInitializer)
     , Event(nullptr)
@@ -36,7 +39,27 @@ UFMODAudioComponent::UFMODAudioComponent(const FObjectInitializer &ObjectInitial
     , AmbientLPF(0.0f)
     , LastVolume(1.0f)
     , LastLPF(MAX_FILTER_FREQUENCY)
+    , CachedInteriorSettings(nullptr)
+    , CachedAudioVolumeLocation(FVector::ZeroVector)
+    , CachedAudioVolumeGeneration(0)
     , wasOccluded(false)
+    , bIsVirtual(false)
+    , bWasVirtual(false)
+    , bSpatialUpdatePending(false)
+    , VirtualUpdateInterval(0.0f)
+    , LastSpatialUpdateTime(0.0)
+    , bVolumeUpdatePending(false)
+    , LastVolumeUpdateTime(0.0)
+    , DistanceBandIndex(INDEX_NONE)
+    , UpdateBandInterval(0.0f)
+    , OcclusionBandInterval(0.0f)
+    , LastAttributesLocation(FVector::ZeroVector)
+    , LastAttributesTime(0.0)
+    , LastOcclusionRequestTime(0.0)
+    , bOcclusionRequestPending(false)
+    , PartialOcclusion(0.0f)
+    , PartialOcclusionRaysRemaining(0)
+    , bPartialOcclusionPrimed(false)
     , OcclusionID()
     , AmbientVolumeID()
     , AmbientLPFID()
@@ -44,6 +67,8 @@ UFMODAudioComponent::UFMODAudioComponent(const FObjectInitializer &ObjectInitial
     , NeedDestroyProgrammerSoundCallback(false)
     , EventLength(0)
     , bPlayEnded(false)
+    , EmitterIndex(INDEX_NONE)
+    , LastEmitterUpdateTime(0.0)
 {
     bAutoActivate = true;
     bNeverNeedsRenderUpdate = true;
@@ -155,22 +180,121 @@ void UFMODAudioComponent::PostEditChangeProperty(FPropertyChangedEvent &e)
 void UFMODAudioComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
 {
     Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
-    if (StudioInstance)
+    if (StudioInstance && !DeferSpatialUpdate())
+    {
+        UpdateSpatialState();
+    }
+}
+
+void UFMODAudioComponent::UpdateSpatialState()
+{
+    const double Now = FApp::GetCurrentTime();
+    const FVector Location = GetComponentTransform().GetLocation();
+    UpdateDistanceBand(Location);
+
+    // At a reduced update rate the position moves in steps, so use the average velocity over the last step to keep the
+    // Doppler effect consistent with it. Long gaps are treated as teleports.
+    FVector Velocity = GetOwner()->GetVelocity();
+    const double Elapsed = Now - LastAttributesTime;
+    if (DistanceBandIndex != INDEX_NONE && UpdateBandInterval > 0.0f && Elapsed > 0.0 && Elapsed < 4.0 * UpdateBandInterval)
+    {
+        Velocity = (Location - LastAttributesLocation) / Elapsed;
+    }
+
+    FMOD_3D_ATTRIBUTES attr = { { 0 } };
+    attr.position = FMODUtils::ConvertWorldVector(Location);
+    attr.up = FMODUtils::ConvertUnitVector(GetComponentTransform().GetUnitAxis(EAxis::Z));
+    attr.forward = FMODUtils::ConvertUnitVector(GetComponentTransform().GetUnitAxis(EAxis::X));
+    attr.velocity = FMODUtils::ConvertWorldVector(Velocity);
+
+    StudioInstance->set3DAttributes(&attr);
+    LastAttributesLocation = Location;
+    LastAttributesTime = Now;
+
+    bSpatialUpdatePending = false;
+    LastSpatialUpdateTime = Now;
+
+    if (!DeferVolumeUpdate())
+    {
+        UpdateVolumes();
+    }
+}
+
+void UFMODAudioComponent::UpdateVolumes()
+{
+    UpdateInteriorVolumes();
+    UpdateAttenuation();
+    ApplyVolumeLPF();
+
+    bVolumeUpdatePending = false;
+    LastVolumeUpdateTime = FApp::GetCurrentTime();
+}
+
+bool UFMODAudioComponent::DeferSpatialUpdate()
+{
+    if (UpdateBandInterval > 0.0f && FApp::GetCurrentTime() - LastSpatialUpdateTime < UpdateBandInterval)
+    {
+        bSpatialUpdatePending = true;
+        return true;
+    }
+    return false;
+}
+
+bool UFMODAudioComponent::DeferVolumeUpdate()
+{
+    if (bIsVirtual && VirtualUpdateInterval > 0.0f && FApp::GetCurrentTime() - LastVolumeUpdateTime < VirtualUpdateInterval)
+    {
+        bVolumeUpdatePending = true;
+        return true;
+    }
+    return false;
+}
+
+void UFMODAudioComponent::UpdateDistanceBand(const FVector &Location)
+{
+    const TArray<FFMODUpdateBand> &Bands = GetDefault<UFMODSettings>()->UpdateBands;
+    if (Bands.Num() == 0 && DistanceBandIndex == INDEX_NONE)
     {
-        FMOD_3D_ATTRIBUTES attr = { { 0 } };
-        attr.position = FMODUtils::ConvertWorldVector(GetComponentTransform().GetLocation());
-        attr.up = FMODUtils::ConvertUnitVector(GetComponentTransform().GetUnitAxis(EAxis::Z));
-        attr.forward = FMODUtils::ConvertUnitVector(GetComponentTransform().GetUnitAxis(EAxis::X));
-        attr.velocity = FMODUtils::ConvertWorldVector(GetOwner()->GetVelocity());
+        return;
+    }
 
-        StudioInstance->set3DAttributes(&attr);
+    const FFMODListener &Listener = GetStudioModule().GetNearestListener(Location);
+    const float Distance = FVector::Dist(Location, Listener.Transform.GetLocation());
 
-        UpdateInteriorVolumes();
-        UpdateAttenuation();
-        ApplyVolumeLPF();
+    // The band with the furthest start distance that we are beyond
+    int32 NewBandIndex = INDEX_NONE;
+    for (int32 i = 0; i < Bands.Num(); ++i)
+    {
+        if (Bands[i].Distance <= Distance && (NewBandIndex == INDEX_NONE || Bands[i].Distance > Bands[NewBandIndex].Distance))
+        {
+            NewBandIndex = i;
+        }
+    }
+
+    if (NewBandIndex != DistanceBandIndex)
+    {
+        DistanceBandIndex = NewBandIndex;
+        UpdateBandInterval = NewBandIndex != INDEX_NONE ? Bands[NewBandIndex].UpdateInterval : 0.0f;
+        OcclusionBandInterval = NewBandIndex != INDEX_NONE ? Bands[NewBandIndex].OcclusionInterval : 0.0f;
+        SetComponentTickInterval(UpdateBandInterval);
     }
 }
 
+void UFMODAudioComponent::RequestOcclusion()
+{
+    const double Now = FApp::GetCurrentTime();
+    if (OcclusionBandInterval > 0.0f && Now - LastOcclusionRequestTime < OcclusionBandInterval)
+    {
+        bOcclusionRequestPending = true;
+        return;
+    }
+
+    PartialOcclusionRaysRemaining = OcclusionDetails.OcclusionRayCount;
+    GetStudioModule().RequestOcclusionUpdate(this);
+    LastOcclusionRequestTime = Now;
+    bOcclusionRequestPending = false;
+}
+
 // Taken mostly from ActiveSound.cpp
 void UFMODAudioComponent::UpdateInteriorVolumes()
 {
@@ -184,10 +308,21 @@ void UFMODAudioComponent::UpdateInteriorVolumes()
     float NewAmbientVolumeMultiplier = 1.0f;
     float NewAmbientHighFrequencyGain = 1.0f;
 
-    FInteriorSettings *Ambient =
-        (FInteriorSettings *)alloca(sizeof(FInteriorSettings)); // FinteriorSetting::FInteriorSettings() isn't exposed (possible UE4 bug???)
     const FVector &Location = GetOwner()->GetTransform().GetTranslation();
-    AAudioVolume *AudioVolume = GetWorld()->GetAudioSettings(Location, NULL, Ambient);
+
+    // Only look the volume up again once we have moved far enough, or it may have changed
+    AAudioVolume *AudioVolume = CachedAudioVolume.Get();
+    const float QueryDistance = GetDefault<UFMODSettings>()->AudioVolumeQueryDistance;
+    if (!CachedInteriorSettings || CachedAudioVolumeGeneration != GetStudioModule().GetAudioVolumeGeneration() ||
+        CachedAudioVolume.IsStale() || (AudioVolume && !AudioVolume->GetEnabled()) ||
+        FVector::DistSquared(Location, CachedAudioVolumeLocation) >= FMath::Square(QueryDistance))
+    {
+        AudioVolume = GetStudioModule().FindAudioVolume(GetWorld(), Location, CachedInteriorSettings);
+        CachedAudioVolume = AudioVolume;
+        CachedAudioVolumeLocation = Location;
+        CachedAudioVolumeGeneration = GetStudioModule().GetAudioVolumeGeneration();
+    }
+    const FInteriorSettings *Ambient = CachedInteriorSettings;
 
     const FFMODListener &Listener = GetStudioModule().GetNearestListener(Location);
     if (InteriorLastUpdateTime < Listener.InteriorStartTime)
@@ -270,27 +405,47 @@ void UFMODAudioComponent::UpdateAttenuation()
         SetProperty(EFMODEventProperty::MaximumDistance, AttenuationDetails.MaximumDistance);
     }
 
-    // Use occlusion part of settings
+    // Use occlusion part of settings. The trace is made asynchronously by the occlusion scheduler, which calls ApplyOcclusion.
+    // Virtual instances can't be heard, so they aren't traced until they become real again
     if (OcclusionDetails.bEnableOcclusion && bApplyOcclusionParameter)
     {
-        static FName NAME_SoundOcclusion = FName(TEXT("SoundOcclusion"));
-        FCollisionQueryParams Params(NAME_SoundOcclusion, OcclusionDetails.bUseComplexCollisionForOcclusion, GetOwner());
-
-        const FVector &Location = GetOwner()->GetTransform().GetTranslation();
-        const FFMODListener &Listener = GetStudioModule().GetNearestListener(Location);
-
-        bool bIsOccluded = GWorld->LineTraceTestByChannel(Location, Listener.Transform.GetLocation(), OcclusionDetails.OcclusionTraceChannel, Params);
+        if (!bIsVirtual || VirtualUpdateInterval <= 0.0f)
+        {
+            RequestOcclusion();
+        }
+    }
+    else
+    {
+        wasOccluded = false;
+        bPartialOcclusionPrimed = false;
+    }
+}
 
+bool UFMODAudioComponent::ApplyOcclusion(bool bIsOccluded)
+{
+    if (!OcclusionDetails.bEnablePartialOcclusion)
+    {
         if (bIsOccluded != wasOccluded)
         {
             StudioInstance->setParameterByID(OcclusionID, bIsOccluded ? 1.0f : 0.0f);
             wasOccluded = bIsOccluded;
         }
+        return false;
     }
-    else
+
+    // An exponential moving average over roughly the last OcclusionRayCount rays
+    const float Sample = bIsOccluded ? 1.0f : 0.0f;
+    const float Alpha = 1.0f / FMath::Max(OcclusionDetails.OcclusionRayCount, 1);
+    const float NewOcclusion = bPartialOcclusionPrimed ? FMath::Lerp(PartialOcclusion, Sample, Alpha) : Sample;
+
+    if (!bPartialOcclusionPrimed || !FMath::IsNearlyEqual(NewOcclusion, PartialOcclusion, 0.001f))
     {
-        wasOccluded = false;
+        StudioInstance->setParameterByID(OcclusionID, NewOcclusion);
     }
+    PartialOcclusion = NewOcclusion;
+    bPartialOcclusionPrimed = true;
+
+    return --PartialOcclusionRaysRemaining > 0;
 }
 
 void UFMODAudioComponent::ApplyVolumeLPF()
@@ -375,6 +530,10 @@ void UFMODAudioComponent::OnUnregister()
         Stop();
     }
     Release();
+    if (EmitterIndex != INDEX_NONE && IFMODStudioModule::IsAvailable())
+    {
+        IFMODStudioModule::Get().UnregisterEmitter(this);
+    }
     Super::OnUnregister();
 }
 
@@ -383,6 +542,7 @@ void UFMODAudioComponent::BeginPlay()
 #if WITH_EDITOR
     IFMODStudioModule::Get().PreEndPIEEvent().AddUObject(this, &UFMODAudioComponent::Shutdown);
 #endif
+    IFMODStudioModule::Get().RegisterPrefetchComponent(this);
     Super::BeginPlay();
 }
 
@@ -391,6 +551,8 @@ void UFMODAudioComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 #if WITH_EDITOR
     IFMODStudioModule::Get().PreEndPIEEvent().RemoveAll(this);
 #endif
+    IFMODStudioModule::Get().UnregisterPrefetchComponent(this);
+    IFMODStudioModule::Get().CancelOcclusionUpdate(this);
     Super::EndPlay(EndPlayReason);
     bool shouldStop = false;
 
@@ -433,50 +595,80 @@ void UFMODAudioComponent::TickComponent(float DeltaTime, enum ELevelTick TickTyp
 
         if (StudioInstance)
         {
-            if (GetStudioModule().HasListenerMoved())
-            {
-                UpdateInteriorVolumes();
-                UpdateAttenuation();
-                ApplyVolumeLPF();
-            }
+            TickEmitter();
+            StudioInstance->getPlaybackState(&state);
+        }
 
-            if (bEnableTimelineCallbacks)
-            {
-                TArray<FTimelineMarkerProperties> LocalMarkerQueue;
-                TArray<FTimelineBeatProperties> LocalBeatQueue;
-                {
-                    FScopeLock Lock(&CallbackLock);
-                    Swap(LocalMarkerQueue, CallbackMarkerQueue);
-                    Swap(LocalBeatQueue, CallbackBeatQueue);
-                }
+        if (state == FMOD_STUDIO_PLAYBACK_STOPPED)
+        {
+            OnPlaybackCompleted();
+        }
+    }
+}
 
-                for (const FTimelineMarkerProperties &EachProps : LocalMarkerQueue)
-                {
-                    OnTimelineMarker.Broadcast(EachProps.Name, EachProps.Position);
-                }
-                for (const FTimelineBeatProperties &EachProps : LocalBeatQueue)
-                {
-                    OnTimelineBeat.Broadcast(
-                        EachProps.Bar, EachProps.Beat, EachProps.Position, EachProps.Tempo, EachProps.TimeSignatureUpper, EachProps.TimeSignatureLower);
-                }
-            }
+void UFMODAudioComponent::TickEmitter()
+{
+    // Catch up on everything skipped while virtual as soon as the instance becomes real
+    const bool bVirtual = bIsVirtual;
+    if (bWasVirtual && !bVirtual)
+    {
+        bVolumeUpdatePending = true;
+    }
+    bWasVirtual = bVirtual;
 
-            if (TriggerSoundStoppedDelegate)
-            {
-                FScopeLock Lock(&CallbackLock);
-                TriggerSoundStoppedDelegate = false;
+    if (bSpatialUpdatePending)
+    {
+        if (!DeferSpatialUpdate())
+        {
+            UpdateSpatialState();
+        }
+    }
+    else if ((bVolumeUpdatePending || GetStudioModule().HasListenerMoved()) && !DeferSpatialUpdate() && !DeferVolumeUpdate())
+    {
+        UpdateDistanceBand(GetComponentTransform().GetLocation());
+        UpdateVolumes();
+        LastSpatialUpdateTime = FApp::GetCurrentTime();
+    }
+    else if (bOcclusionRequestPending && (!bIsVirtual || VirtualUpdateInterval <= 0.0f))
+    {
+        // Occlusion is traced less often than the other updates in the further distance bands
+        RequestOcclusion();
+    }
 
-                OnSoundStopped.Broadcast();
+    if (bEnableTimelineCallbacks && CallbackMarkerQueue.IsValid())
+    {
+        FTimelineMarkerProperties MarkerProps;
+        while (CallbackMarkerQueue->Dequeue(MarkerProps))
+        {
+            // Names are converted on the stack for the comparison, so only new names allocate. Different names with the
+            // same hash replace each other rather than broadcasting the wrong one.
+            FUTF8ToTCHAR DequeuedName(MarkerProps.Name);
+            FString *Name = MarkerNames.Find(MarkerProps.NameHash);
+            if (!Name || FCString::Strcmp(**Name, DequeuedName.Get()) != 0)
+            {
+                Name = &MarkerNames.Add(MarkerProps.NameHash, FString(DequeuedName.Length(), DequeuedName.Get()));
             }
+            OnTimelineMarker.Broadcast(*Name, MarkerProps.Position);
+        }
 
-            StudioInstance->getPlaybackState(&state);
+        FTimelineBeatProperties BeatProps;
+        while (CallbackBeatQueue->Dequeue(BeatProps))
+        {
+            OnTimelineBeat.Broadcast(
+                BeatProps.Bar, BeatProps.Beat, BeatProps.Position, BeatProps.Tempo, BeatProps.TimeSignatureUpper, BeatProps.TimeSignatureLower);
         }
 
-        if (state == FMOD_STUDIO_PLAYBACK_STOPPED)
+        const int32 Dropped = DroppedTimelineCallbacks.Reset();
+        if (Dropped > 0)
         {
-            OnPlaybackCompleted();
+            UE_LOG(LogFMOD, Warning, TEXT("Dropped %d timeline callbacks for component %s"), Dropped, *GetName());
         }
     }
+
+    if (TriggerSoundStoppedDelegate.AtomicSet(false))
+    {
+        OnSoundStopped.Broadcast();
+    }
 }
 
 void UFMODAudioComponent::SetEvent(UFMODEvent *NewEvent)
@@ -546,6 +738,14 @@ FMOD_RESULT F_CALLBACK UFMODAudioComponent_EventCallback(FMOD_STUDIO_EVENT_CALLB
         {
             Component->EventCallbackSoundStopped();
         }
+        else if (type == FMOD_STUDIO_EVENT_CALLBACK_REAL_TO_VIRTUAL)
+        {
+            Component->bIsVirtual = true;
+        }
+        else if (type == FMOD_STUDIO_EVENT_CALLBACK_VIRTUAL_TO_REAL)
+        {
+            Component->bIsVirtual = false;
+        }
     }
     return FMOD_OK;
 }
@@ -554,9 +754,15 @@ void UFMODAudioComponent_ReleaseProgrammerSound(FMOD_STUDIO_PROGRAMMER_SOUND_PRO
 {
     if (props->sound)
     {
-        UE_LOG(LogFMOD, Verbose, TEXT("Destroying programmer sound"));
-        FMOD_RESULT Result = ((FMOD::Sound *)props->sound)->release();
-        verifyfmod(Result);
+        if (IFMODStudioModule::IsAvailable())
+        {
+            IFMODStudioModule::Get().ReleaseProgrammerSound((FMOD::Sound *)props->sound);
+        }
+        else
+        {
+            UE_LOG(LogFMOD, Verbose, TEXT("Destroying programmer sound"));
+            verifyfmod(((FMOD::Sound *)props->sound)->release());
+        }
     }
 }
 
@@ -568,16 +774,29 @@ FMOD_RESULT F_CALLBACK UFMODAudioComponent_EventCallbackDestroyProgrammerSound(F
 
 void UFMODAudioComponent::EventCallbackAddMarker(FMOD_STUDIO_TIMELINE_MARKER_PROPERTIES *props)
 {
-    FScopeLock Lock(&CallbackLock);
+    // Called on the FMOD thread, so don't lock or allocate here
+    if (!CallbackMarkerQueue.IsValid())
+    {
+        return;
+    }
+
     FTimelineMarkerProperties info;
-    info.Name = props->name;
+    FCStringAnsi::Strncpy(info.Name, props->name, FTimelineMarkerProperties::MaxNameLength);
+    info.NameHash = FCrc::StrCrc32(info.Name);
     info.Position = props->position;
-    CallbackMarkerQueue.Push(info);
+    if (!CallbackMarkerQueue->Enqueue(info))
+    {
+        DroppedTimelineCallbacks.Increment();
+    }
 }
 
 void UFMODAudioComponent::EventCallbackAddBeat(FMOD_STUDIO_TIMELINE_BEAT_PROPERTIES *props)
 {
-    FScopeLock Lock(&CallbackLock);
+    if (!CallbackBeatQueue.IsValid())
+    {
+        return;
+    }
+
     FTimelineBeatProperties info;
     info.Bar = props->bar;
     info.Beat = props->beat;
@@ -585,7 +804,10 @@ void UFMODAudioComponent::EventCallbackAddBeat(FMOD_STUDIO_TIMELINE_BEAT_PROPERT
     info.Tempo = props->tempo;
     info.TimeSignatureUpper = props->timesignatureupper;
     info.TimeSignatureLower = props->timesignaturelower;
-    CallbackBeatQueue.Push(info);
+    if (!CallbackBeatQueue->Enqueue(info))
+    {
+        DroppedTimelineCallbacks.Increment();
+    }
 }
 
 void UFMODAudioComponent::EventCallbackCreateProgrammerSound(FMOD_STUDIO_PROGRAMMER_SOUND_PROPERTIES *props)
@@ -604,92 +826,20 @@ void UFMODAudioComponent::EventCallbackCreateProgrammerSound(FMOD_STUDIO_PROGRAM
     }
     else if (ProgrammerSoundNameCopy.Len() || strlen(props->name) != 0)
     {
-        FMOD::Studio::System *System = GetStudioModule().GetStudioSystem(EFMODSystemContext::Max);
-        FMOD::System *LowLevelSystem = nullptr;
-        System->getCoreSystem(&LowLevelSystem);
         FString SoundName = ProgrammerSoundNameCopy.Len() ? ProgrammerSoundNameCopy : UTF8_TO_TCHAR(props->name);
-        FMOD_MODE SoundMode = FMOD_LOOP_NORMAL | FMOD_CREATECOMPRESSEDSAMPLE | FMOD_NONBLOCKING;
-
-        if (SoundName.StartsWith(TEXT("http://")) || 
-            SoundName.StartsWith(TEXT("http:\\\\")) || 
-            SoundName.StartsWith(TEXT("https://")) || 
-            SoundName.StartsWith(TEXT("https:\\\\")))
+        int32 SubsoundIndex = -1;
+        FMOD::Sound *Sound = GetStudioModule().AcquireProgrammerSound(SoundName, SubsoundIndex);
+        if (Sound)
         {
-            // Load via url
-            FMOD::Sound* Sound = nullptr;
-            FMOD_CREATESOUNDEXINFO exinfo;
-            memset(&exinfo, 0, sizeof(FMOD_CREATESOUNDEXINFO));
-            exinfo.cbsize = sizeof(FMOD_CREATESOUNDEXINFO);
-            exinfo.filebuffersize = 1024 * 16;
-            exinfo.ignoresetfilesystem = true;
-
-            if (LowLevelSystem->createSound(TCHAR_TO_UTF8(*SoundName), FMOD_CREATESTREAM | FMOD_NONBLOCKING, &exinfo, &Sound) == FMOD_OK)
-            {
-                UE_LOG(LogFMOD, Verbose, TEXT("Creating programmer sound from url '%s'"), *SoundName);
-                props->sound = (FMOD_SOUND*)Sound;
-                props->subsoundIndex = -1;
-                NeedDestroyProgrammerSoundCallback = true;
-            }
-            else
-            {
-                UE_LOG(LogFMOD, Warning, TEXT("Failed to load programmer sound url '%s'"), *SoundName);
-            }
-        }
-        else if (SoundName.Contains(TEXT(".")))
-        {
-            // Load via file
-            FString SoundPath = SoundName;
-            if (FPaths::IsRelative(SoundPath))
-            {
-                SoundPath = FPaths::ProjectContentDir() / SoundPath;
-            }
-
-            FMOD::Sound *Sound = nullptr;
-            if (LowLevelSystem->createSound(TCHAR_TO_UTF8(*SoundPath), SoundMode, nullptr, &Sound) == FMOD_OK)
-            {
-                UE_LOG(LogFMOD, Verbose, TEXT("Creating programmer sound from file '%s'"), *SoundPath);
-                props->sound = (FMOD_SOUND *)Sound;
-                props->subsoundIndex = -1;
-                NeedDestroyProgrammerSoundCallback = true;
-            }
-            else
-            {
-                UE_LOG(LogFMOD, Warning, TEXT("Failed to load programmer sound file '%s'"), *SoundPath);
-            }
-        }
-        else
-        {
-            // Load via FMOD Studio asset table
-            FMOD_STUDIO_SOUND_INFO SoundInfo = { 0 };
-            FMOD_RESULT Result = System->getSoundInfo(TCHAR_TO_UTF8(*SoundName), &SoundInfo);
-            if (Result == FMOD_OK)
-            {
-                FMOD::Sound *Sound = nullptr;
-                Result = LowLevelSystem->createSound(SoundInfo.name_or_data, SoundMode | SoundInfo.mode, &SoundInfo.exinfo, &Sound);
-                if (Result == FMOD_OK)
-                {
-                    UE_LOG(LogFMOD, Verbose, TEXT("Creating programmer sound using audio entry '%s'"), *SoundName);
-
-                    props->sound = (FMOD_SOUND *)Sound;
-                    props->subsoundIndex = SoundInfo.subsoundindex;
-                    NeedDestroyProgrammerSoundCallback = true;
-                }
-                else
-                {
-                    UE_LOG(LogFMOD, Warning, TEXT("Failed to load FMOD audio entry '%s'"), *SoundName);
-                }
-            }
-            else
-            {
-                UE_LOG(LogFMOD, Warning, TEXT("Failed to find FMOD audio entry '%s'"), *SoundName);
-            }
+            props->sound = (FMOD_SOUND *)Sound;
+            props->subsoundIndex = SubsoundIndex;
+            NeedDestroyProgrammerSoundCallback = true;
         }
     }
 }
 
 void UFMODAudioComponent::EventCallbackSoundStopped()
 {
-    FScopeLock Lock(&CallbackLock);
     TriggerSoundStoppedDelegate = true;
 }
 
@@ -737,10 +887,11 @@ void UFMODAudioComponent::PlayInternal(EFMODSystemContext::Type Context, bool bR
         EventDesc->getLength(&EventLength);
         if (!StudioInstance || !StudioInstance->isValid())
         {
-            FMOD_RESULT result = EventDesc->createInstance(&StudioInstance);
-            if (result != FMOD_OK)
+            StudioInstance = GetStudioModule().AcquireEventInstance(EventDesc);
+            if (!StudioInstance)
                 return;
         }
+        ParameterIds = GetStudioModule().GetParameterIds(EventDesc);
 
         const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
         FMOD_STUDIO_PARAMETER_DESCRIPTION paramDesc = {};
@@ -778,16 +929,27 @@ void UFMODAudioComponent::PlayInternal(EFMODSystemContext::Type Context, bool bR
             }
         }
 
-        OnUpdateTransform(EUpdateTransformFlags::SkipPhysicsUpdate);
-        // Set initial parameters
-        for (auto Kvp : ParameterCache)
+        bIsVirtual = false;
+        bWasVirtual = false;
+        VirtualUpdateInterval = Settings.VirtualEmitterUpdateInterval;
+        if (DistanceBandIndex != INDEX_NONE)
         {
-            FMOD_RESULT Result = StudioInstance->setParameterByName(TCHAR_TO_UTF8(*Kvp.Key.ToString()), Kvp.Value);
-            if (Result != FMOD_OK)
-            {
-                UE_LOG(LogFMOD, Warning, TEXT("Failed to set initial parameter %s"), *Kvp.Key.ToString());
-            }
+            DistanceBandIndex = INDEX_NONE;
+            UpdateBandInterval = 0.0f;
+            OcclusionBandInterval = 0.0f;
+            SetComponentTickInterval(0.0f);
         }
+        LastAttributesTime = 0.0;
+        LastSpatialUpdateTime = 0.0;
+        LastEmitterUpdateTime = 0.0;
+        bSpatialUpdatePending = false;
+        LastVolumeUpdateTime = 0.0;
+        bVolumeUpdatePending = false;
+        bOcclusionRequestPending = false;
+
+        OnUpdateTransform(EUpdateTransformFlags::SkipPhysicsUpdate);
+        // Set initial parameters
+        ApplyParameters(ParameterCache);
         for (int i = 0; i < EFMODEventProperty::Count; ++i)
         {
             if (StoredProperties[i] != -1.0f)
@@ -800,10 +962,22 @@ void UFMODAudioComponent::PlayInternal(EFMODSystemContext::Type Context, bool bR
             }
         }
 
+        if (bEnableTimelineCallbacks && !CallbackMarkerQueue.IsValid())
+        {
+            // The queues are kept for the lifetime of the component, as the FMOD thread may still be writing to them
+            CallbackMarkerQueue = MakeUnique<TCircularQueue<FTimelineMarkerProperties>>(TimelineCallbackQueueSize);
+            CallbackBeatQueue = MakeUnique<TCircularQueue<FTimelineBeatProperties>>(TimelineCallbackQueueSize);
+        }
+
         if (bEnableTimelineCallbacks || !ProgrammerSoundName.IsEmpty())
         {
             verifyfmod(StudioInstance->setCallback(UFMODAudioComponent_EventCallback));
         }
+        else if (VirtualUpdateInterval > 0.0f)
+        {
+            verifyfmod(StudioInstance->setCallback(
+                UFMODAudioComponent_EventCallback, FMOD_STUDIO_EVENT_CALLBACK_REAL_TO_VIRTUAL | FMOD_STUDIO_EVENT_CALLBACK_VIRTUAL_TO_REAL));
+        }
 
         verifyfmod(StudioInstance->setUserData(this));
         verifyfmod(StudioInstance->start());
@@ -813,6 +987,13 @@ void UFMODAudioComponent::PlayInternal(EFMODSystemContext::Type Context, bool bR
         {
             Super::Activate(bReset);
         }
+
+        // Game world components can be updated by the emitter manager rather than ticking individually
+        if (IsActive() && GetDefault<UFMODSettings>()->bUseEmitterManager && GetWorld() && GetWorld()->IsGameWorld())
+        {
+            SetComponentTickEnabled(false);
+            GetStudioModule().RegisterEmitter(this);
+        }
     }
 }
 
@@ -856,6 +1037,7 @@ void UFMODAudioComponent::Stop()
     }
 
     wasOccluded = false;
+    bPartialOcclusionPrimed = false;
 }
 
 void UFMODAudioComponent::Release()
@@ -884,16 +1066,26 @@ void UFMODAudioComponent::ReleaseEventInstance()
     {
         if (NeedDestroyProgrammerSoundCallback)
         {
-            // We need a callback to destroy a programmer sound
+            // We need a callback to destroy a programmer sound, so this instance can't be pooled
             StudioInstance->setCallback(UFMODAudioComponent_EventCallbackDestroyProgrammerSound, FMOD_STUDIO_EVENT_CALLBACK_DESTROY_PROGRAMMER_SOUND);
+            StudioInstance->release();
         }
         else
         {
             // We don't want any more callbacks
             StudioInstance->setCallback(nullptr);
+            StudioInstance->setUserData(nullptr);
+
+            if (IFMODStudioModule::IsAvailable())
+            {
+                IFMODStudioModule::Get().ReleaseEventInstance(StudioInstance);
+            }
+            else
+            {
+                StudioInstance->release();
+            }
         }
 
-        StudioInstance->release();
         StudioInstance = nullptr;
     }
 }
@@ -912,6 +1104,10 @@ void UFMODAudioComponent::OnPlaybackCompleted()
     // Mark inactive before calling destroy to avoid recursion
     SetActive(false);
     SetComponentTickEnabled(false);
+    if (EmitterIndex != INDEX_NONE)
+    {
+        GetStudioModule().UnregisterEmitter(this);
+    }
 
     if (StudioInstance)
     {
@@ -988,7 +1184,8 @@ void UFMODAudioComponent::SetParameter(FName Name, float Value)
 {
     if (StudioInstance)
     {
-        FMOD_RESULT Result = StudioInstance->setParameterByName(TCHAR_TO_UTF8(*Name.ToString()), Value);
+        const FMOD_STUDIO_PARAMETER_ID *Id = ParameterIds.IsValid() ? ParameterIds->Find(Name) : nullptr;
+        FMOD_RESULT Result = Id ? StudioInstance->setParameterByID(*Id, Value) : StudioInstance->setParameterByName(TCHAR_TO_UTF8(*Name.ToString()), Value);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to set parameter %s"), *Name.ToString());
@@ -997,6 +1194,47 @@ void UFMODAudioComponent::SetParameter(FName Name, float Value)
     ParameterCache.FindOrAdd(Name) = Value;
 }
 
+void UFMODAudioComponent::SetParameters(const TMap<FName, float> &Parameters)
+{
+    if (StudioInstance)
+    {
+        ApplyParameters(Parameters);
+    }
+    for (const TPair<FName, float> &Parameter : Parameters)
+    {
+        ParameterCache.FindOrAdd(Parameter.Key) = Parameter.Value;
+    }
+}
+
+void UFMODAudioComponent::ApplyParameters(const TMap<FName, float> &Parameters)
+{
+    TArray<FMOD_STUDIO_PARAMETER_ID, TInlineAllocator<16>> Ids;
+    TArray<float, TInlineAllocator<16>> Values;
+
+    for (const TPair<FName, float> &Parameter : Parameters)
+    {
+        const FMOD_STUDIO_PARAMETER_ID *Id = ParameterIds.IsValid() ? ParameterIds->Find(Parameter.Key) : nullptr;
+        if (Id)
+        {
+            Ids.Add(*Id);
+            Values.Add(Parameter.Value);
+        }
+        else if (StudioInstance->setParameterByName(TCHAR_TO_UTF8(*Parameter.Key.ToString()), Parameter.Value) != FMOD_OK)
+        {
+            UE_LOG(LogFMOD, Warning, TEXT("Failed to set parameter %s"), *Parameter.Key.ToString());
+        }
+    }
+
+    if (Ids.Num() > 0)
+    {
+        FMOD_RESULT Result = StudioInstance->setParametersByIDs(Ids.GetData(), Values.GetData(), Ids.Num());
+        if (Result != FMOD_OK)
+        {
+            UE_LOG(LogFMOD, Warning, TEXT("Failed to set %d parameters"), Ids.Num());
+        }
+    }
+}
+
 void UFMODAudioComponent::SetProperty(EFMODEventProperty::Type Property, float Value)
 {
     verify(Property < EFMODEventProperty::Count);
@@ -1068,7 +1306,8 @@ float UFMODAudioComponent::GetParameter(FName Name)
     float Value = CachedValue ? *CachedValue : 0.0;
     if (StudioInstance)
     {
-        FMOD_RESULT Result = StudioInstance->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &Value);
+        const FMOD_STUDIO_PARAMETER_ID *Id = ParameterIds.IsValid() ? ParameterIds->Find(Name) : nullptr;
+        FMOD_RESULT Result = Id ? StudioInstance->getParameterByID(*Id, &Value) : StudioInstance->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &Value);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to get parameter %s"), *Name.ToString());
@@ -1087,7 +1326,9 @@ void UFMODAudioComponent::GetParameterValue(FName Name, float &UserValue, float
     float *CachedValue = ParameterCache.Find(Name);
     if (StudioInstance)
     {
-        FMOD_RESULT Result = StudioInstance->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &UserValue, &FinalValue);
+        const FMOD_STUDIO_PARAMETER_ID *Id = ParameterIds.IsValid() ? ParameterIds->Find(Name) : nullptr;
+        FMOD_RESULT Result = Id ? StudioInstance->getParameterByID(*Id, &UserValue, &FinalValue)
+                                : StudioInstance->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &UserValue, &FinalValue);
         if (Result != FMOD_OK)
         {
             UserValue = FinalValue = 0;
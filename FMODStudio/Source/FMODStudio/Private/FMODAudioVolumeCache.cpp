@@ -0,0 +1,244 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#include "FMODAudioVolumeCache.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/WorldSettings.h"
+#include "Sound/AudioVolume.h"
+#include "FMODStudioPrivatePCH.h"
+
+namespace
+{
+const float CellSize = 2500.0f;
+
+// Volumes spanning more cells than this (e.g. a level-wide ambient zone) are tested for every lookup instead
+const int32 MaxCellsPerVolume = 512;
+
+FIntVector CellCoord(const FVector &Location)
+{
+    return FIntVector(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize), FMath::FloorToInt(Location.Z / CellSize));
+}
+}
+
+FFMODAudioVolumeCache::FFMODAudioVolumeCache()
+    : Generation(0)
+{
+}
+
+void FFMODAudioVolumeCache::Init()
+{
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FFMODAudioVolumeCache::OnLevelChanged);
+    LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FFMODAudioVolumeCache::OnLevelChanged);
+    WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FFMODAudioVolumeCache::OnWorldCleanup);
+}
+
+void FFMODAudioVolumeCache::Shutdown()
+{
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+    FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+
+    for (TPair<TWeakObjectPtr<UWorld>, FWorldGrid> &Pair : Grids)
+    {
+        if (UWorld *World = Pair.Key.Get())
+        {
+            World->RemoveOnActorSpawnedHandler(Pair.Value.ActorSpawnedHandle);
+        }
+    }
+    Grids.Reset();
+}
+
+AAudioVolume *FFMODAudioVolumeCache::Find(UWorld *World, const FVector &Location, const FInteriorSettings *&OutSettings)
+{
+    if (!World->IsGameWorld())
+    {
+        // Volumes are edited in editor worlds, so don't cache them
+        AAudioVolume *Volume = World->GetAudioSettings(Location, nullptr, nullptr);
+        OutSettings = Volume ? &Volume->GetInteriorSettings() : &World->GetWorldSettings(true)->DefaultAmbientZoneSettings;
+        return Volume;
+    }
+
+    FWorldGrid *Grid = Grids.Find(World);
+    if (!Grid)
+    {
+        Grid = &Grids.Add(World);
+        Grid->ActorSpawnedHandle =
+            World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateRaw(this, &FFMODAudioVolumeCache::OnActorSpawned));
+        Grid->bDirty = true;
+    }
+
+    if (Grid->bDirty)
+    {
+        Build(World, *Grid);
+    }
+
+    static const TArray<int32> NoVolumes;
+    const TArray<int32> *CellVolumes = Grid->Cells.Find(CellCoord(Location));
+    const TArray<int32> &Cell = CellVolumes ? *CellVolumes : NoVolumes;
+    const TArray<int32> &Large = Grid->LargeVolumes;
+
+    // Both lists are in priority order, so merge them to test the volumes in the same order as GetAudioSettings
+    int32 CellIndex = 0;
+    int32 LargeIndex = 0;
+    while (CellIndex < Cell.Num() || LargeIndex < Large.Num())
+    {
+        int32 VolumeIndex;
+        if (LargeIndex >= Large.Num() || (CellIndex < Cell.Num() && Cell[CellIndex] < Large[LargeIndex]))
+        {
+            VolumeIndex = Cell[CellIndex++];
+        }
+        else
+        {
+            VolumeIndex = Large[LargeIndex++];
+        }
+
+        AAudioVolume *Volume = Grid->Volumes[VolumeIndex].Get();
+        if (!Volume)
+        {
+            MarkDirty(*Grid);
+            continue;
+        }
+
+        if (Volume->GetEnabled() && Volume->EncompassesPoint(Location))
+        {
+            OutSettings = &Volume->GetInteriorSettings();
+            return Volume;
+        }
+    }
+
+    OutSettings = &World->GetWorldSettings(true)->DefaultAmbientZoneSettings;
+    return nullptr;
+}
+
+void FFMODAudioVolumeCache::Invalidate()
+{
+    for (TPair<TWeakObjectPtr<UWorld>, FWorldGrid> &Pair : Grids)
+    {
+        MarkDirty(Pair.Value);
+    }
+}
+
+void FFMODAudioVolumeCache::Update()
+{
+    // A world has few enough volumes that checking them all once a frame is cheap, unlike doing it for every lookup
+    for (TPair<TWeakObjectPtr<UWorld>, FWorldGrid> &Pair : Grids)
+    {
+        FWorldGrid &Grid = Pair.Value;
+        if (Grid.bDirty)
+        {
+            continue;
+        }
+
+        bool bChanged = false;
+        for (int32 i = 0; i < Grid.Volumes.Num(); ++i)
+        {
+            AAudioVolume *Volume = Grid.Volumes[i].Get();
+            if (!Volume)
+            {
+                MarkDirty(Grid);
+                bChanged = false;
+                break;
+            }
+
+            const bool bEnabled = Volume->GetEnabled();
+            if (Grid.Enabled[i] != bEnabled)
+            {
+                Grid.Enabled[i] = bEnabled;
+                bChanged = true;
+            }
+        }
+
+        if (bChanged)
+        {
+            ++Generation;
+        }
+    }
+}
+
+void FFMODAudioVolumeCache::MarkDirty(FWorldGrid &Grid)
+{
+    if (!Grid.bDirty)
+    {
+        Grid.bDirty = true;
+        ++Generation;
+    }
+}
+
+void FFMODAudioVolumeCache::Build(UWorld *World, FWorldGrid &Grid)
+{
+    Grid.Volumes.Reset();
+    Grid.Enabled.Reset();
+    Grid.Cells.Reset();
+    Grid.LargeVolumes.Reset();
+    Grid.bDirty = false;
+    ++Generation;
+
+    TArray<AAudioVolume *> Volumes;
+    for (TActorIterator<AAudioVolume> It(World); It; ++It)
+    {
+        Volumes.Add(*It);
+    }
+
+    // Same order as UWorld::AudioVolumes
+    Volumes.StableSort([](const AAudioVolume &A, const AAudioVolume &B) { return A.GetPriority() > B.GetPriority(); });
+
+    for (AAudioVolume *Volume : Volumes)
+    {
+        const int32 VolumeIndex = Grid.Volumes.Add(Volume);
+        Grid.Enabled.Add(Volume->GetEnabled());
+        const FBox Bounds = Volume->GetComponentsBoundingBox(true);
+        if (!Bounds.IsValid)
+        {
+            continue;
+        }
+
+        const FIntVector Min = CellCoord(Bounds.Min);
+        const FIntVector Max = CellCoord(Bounds.Max);
+        const int64 CellCount = int64(Max.X - Min.X + 1) * (Max.Y - Min.Y + 1) * (Max.Z - Min.Z + 1);
+        if (CellCount > MaxCellsPerVolume)
+        {
+            Grid.LargeVolumes.Add(VolumeIndex);
+            continue;
+        }
+
+        for (int32 X = Min.X; X <= Max.X; ++X)
+        {
+            for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+            {
+                for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+                {
+                    Grid.Cells.FindOrAdd(FIntVector(X, Y, Z)).Add(VolumeIndex);
+                }
+            }
+        }
+    }
+}
+
+void FFMODAudioVolumeCache::OnLevelChanged(ULevel *Level, UWorld *World)
+{
+    if (FWorldGrid *Grid = Grids.Find(World))
+    {
+        MarkDirty(*Grid);
+    }
+}
+
+void FFMODAudioVolumeCache::OnWorldCleanup(UWorld *World, bool bSessionEnded, bool bCleanupResources)
+{
+    FWorldGrid Grid;
+    if (Grids.RemoveAndCopyValue(World, Grid))
+    {
+        World->RemoveOnActorSpawnedHandler(Grid.ActorSpawnedHandle);
+        ++Generation;
+    }
+}
+
+void FFMODAudioVolumeCache::OnActorSpawned(AActor *Actor)
+{
+    if (Actor->IsA<AAudioVolume>())
+    {
+        if (FWorldGrid *Grid = Grids.Find(Actor->GetWorld()))
+        {
+            MarkDirty(*Grid);
+        }
+    }
+}
@@ -0,0 +1,72 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class AActor;
+class AAudioVolume;
+class ULevel;
+class UWorld;
+struct FInteriorSettings;
+
+/*
+    A replacement for UWorld::GetAudioSettings that doesn't test every audio volume in the world. The volumes of each
+    game world are bucketed into a uniform grid by their bounds, and a lookup only tests the volumes overlapping the
+    cell containing the location, in priority order. The grid is rebuilt when levels are added or removed, when an audio
+    volume is spawned, or after Invalidate (for example when a volume is moved at runtime). Volumes being enabled or
+    disabled are picked up by Update. Other worlds fall back to UWorld::GetAudioSettings.
+*/
+class FFMODAudioVolumeCache
+{
+public:
+    FFMODAudioVolumeCache();
+
+    void Init();
+    void Shutdown();
+
+    /** Returns the highest priority enabled volume containing Location, or null, and the interior settings that apply there. */
+    AAudioVolume *Find(UWorld *World, const FVector &Location, const FInteriorSettings *&OutSettings);
+
+    /** Rebuilds the grids on their next use. */
+    void Invalidate();
+
+    /** Checks whether any cached volume has been enabled, disabled or destroyed, and bumps the generation if so. */
+    void Update();
+
+    /** Changes whenever the grids are rebuilt, so callers can tell when results they cached may be out of date. */
+    uint32 GetGeneration() const { return Generation; }
+
+private:
+    struct FWorldGrid
+    {
+        /** Audio volumes in descending priority order. Cells refer to volumes by index, so lower indices win. */
+        TArray<TWeakObjectPtr<AAudioVolume>> Volumes;
+        /** Whether each volume was enabled when last checked by Update */
+        TBitArray<> Enabled;
+        TMap<FIntVector, TArray<int32>> Cells;
+
+        /** Volumes covering too many cells to bucket, which are tested for every lookup. */
+        TArray<int32> LargeVolumes;
+
+        FDelegateHandle ActorSpawnedHandle;
+        bool bDirty;
+    };
+
+    void Build(UWorld *World, FWorldGrid &Grid);
+
+    /** Rebuilds a grid on its next use. The generation changes now so cached lookups are redone, which rebuilds it. */
+    void MarkDirty(FWorldGrid &Grid);
+
+    void OnLevelChanged(ULevel *Level, UWorld *World);
+    void OnWorldCleanup(UWorld *World, bool bSessionEnded, bool bCleanupResources);
+    void OnActorSpawned(AActor *Actor);
+
+    TMap<TWeakObjectPtr<UWorld>, FWorldGrid> Grids;
+    uint32 Generation;
+
+    FDelegateHandle LevelAddedHandle;
+    FDelegateHandle LevelRemovedHandle;
+    FDelegateHandle WorldCleanupHandle;
+};
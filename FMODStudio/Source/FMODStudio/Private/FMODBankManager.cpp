@@ -0,0 +1,135 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#include "FMODBankManager.h"
+#include "FMODBankManifest.h"
+#include "FMODBank.h"
+#include "FMODStudioModule.h"
+#include "FMODUtils.h"
+#include "fmod_studio.hpp"
+#include "fmod_errors.h"
+#include "FMODStudioPrivatePCH.h"
+
+void FFMODBankManager::Acquire(FMOD::Studio::System *System, const UFMODBankManifest &Manifest)
+{
+    if (!System)
+    {
+        return;
+    }
+
+    for (const UFMODBank *Bank : Manifest.Banks)
+    {
+        if (!IsValid(Bank))
+        {
+            continue;
+        }
+
+        FBankEntry &Entry = Banks.FindOrAdd(Bank->AssetGuid);
+        if (Entry.RefCount++ == 0)
+        {
+            Entry.Name = Bank->GetName();
+            FMOD::Studio::ID Guid = FMODUtils::ConvertGuid(Bank->AssetGuid);
+            if (System->getBankByID(&Guid, &Entry.Bank) == FMOD_OK && Entry.Bank)
+            {
+                UE_LOG(LogFMOD, Verbose, TEXT("Bank manifest %s sharing already loaded bank %s"), *Manifest.GetName(), *Bank->GetName());
+                Entry.bOwned = false;
+            }
+            else
+            {
+                UE_LOG(LogFMOD, Log, TEXT("Bank manifest %s loading bank %s"), *Manifest.GetName(), *Bank->GetName());
+
+                FString BankPath = IFMODStudioModule::Get().GetBankPath(*Bank);
+                FMOD_RESULT Result = System->loadBankFile(TCHAR_TO_UTF8(*BankPath), FMOD_STUDIO_LOAD_BANK_NONBLOCKING, &Entry.Bank);
+                if (Result != FMOD_OK)
+                {
+                    UE_LOG(LogFMOD, Error, TEXT("Failed to load bank %s: %s"), *Bank->GetName(), UTF8_TO_TCHAR(FMOD_ErrorString(Result)));
+                    Entry.Bank = nullptr;
+                }
+                Entry.bOwned = (Entry.Bank != nullptr);
+                Entry.bLoadPending = Entry.bOwned;
+            }
+        }
+
+        if (Manifest.bLoadSampleData && Entry.Bank && Entry.SampleDataRefCount++ == 0)
+        {
+            verifyfmod(Entry.Bank->loadSampleData());
+            Entry.bSampleDataPending = true;
+        }
+    }
+}
+
+bool FFMODBankManager::Release(const UFMODBankManifest &Manifest)
+{
+    bool bUnloaded = false;
+    for (const UFMODBank *Bank : Manifest.Banks)
+    {
+        if (!IsValid(Bank))
+        {
+            continue;
+        }
+
+        FBankEntry *Entry = Banks.Find(Bank->AssetGuid);
+        if (!Entry)
+        {
+            continue;
+        }
+
+        // Unloading a bank we own releases its sample data too, otherwise balance the loadSampleData from Acquire
+        const bool bUnloadingBank = (Entry->bOwned && Entry->RefCount == 1);
+        if (Manifest.bLoadSampleData && Entry->Bank && --Entry->SampleDataRefCount == 0 && !bUnloadingBank)
+        {
+            verifyfmod(Entry->Bank->unloadSampleData());
+            Entry->bSampleDataPending = false;
+        }
+
+        if (--Entry->RefCount == 0)
+        {
+            if (Entry->bOwned)
+            {
+                UE_LOG(LogFMOD, Log, TEXT("Bank manifest %s unloading bank %s"), *Manifest.GetName(), *Bank->GetName());
+                verifyfmod(Entry->Bank->unload());
+                bUnloaded = true;
+            }
+            Banks.Remove(Bank->AssetGuid);
+        }
+    }
+    return bUnloaded;
+}
+
+void FFMODBankManager::Update()
+{
+    for (auto &Pair : Banks)
+    {
+        FBankEntry &Entry = Pair.Value;
+        if (!Entry.Bank)
+        {
+            continue;
+        }
+
+        if (Entry.bLoadPending)
+        {
+            FMOD_STUDIO_LOADING_STATE State = FMOD_STUDIO_LOADING_STATE_LOADING;
+            FMOD_RESULT Result = Entry.Bank->getLoadingState(&State);
+            if (State == FMOD_STUDIO_LOADING_STATE_ERROR)
+            {
+                UE_LOG(LogFMOD, Error, TEXT("Failed to load bank %s: %s"), *Entry.Name, UTF8_TO_TCHAR(FMOD_ErrorString(Result)));
+            }
+            Entry.bLoadPending = (State == FMOD_STUDIO_LOADING_STATE_LOADING);
+        }
+
+        if (Entry.bSampleDataPending && !Entry.bLoadPending)
+        {
+            FMOD_STUDIO_LOADING_STATE State = FMOD_STUDIO_LOADING_STATE_LOADING;
+            FMOD_RESULT Result = Entry.Bank->getSampleLoadingState(&State);
+            if (State == FMOD_STUDIO_LOADING_STATE_ERROR)
+            {
+                UE_LOG(LogFMOD, Error, TEXT("Failed to load sample data of bank %s: %s"), *Entry.Name, UTF8_TO_TCHAR(FMOD_ErrorString(Result)));
+            }
+            Entry.bSampleDataPending = (State == FMOD_STUDIO_LOADING_STATE_LOADING);
+        }
+    }
+}
+
+void FFMODBankManager::Reset()
+{
+    Banks.Reset();
+}
@@ -0,0 +1,65 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace FMOD
+{
+namespace Studio
+{
+class System;
+class Bank;
+}
+}
+
+class UFMODBankManifest;
+
+/*
+    Reference counts banks across the bank manifests in use, loading each bank when the first manifest using it is
+    acquired and unloading it when the last one is released. Banks that were already loaded by other means (such as
+    bLoadAllBanks or UFMODBlueprintStatics::LoadBank) are shared but never unloaded here, although sample data loaded
+    on them for a manifest is unloaded again once no manifest needs it.
+*/
+class FFMODBankManager
+{
+public:
+    void Acquire(FMOD::Studio::System *System, const UFMODBankManifest &Manifest);
+
+    /** Releases the banks of a manifest, and returns true if any of them were unloaded. */
+    bool Release(const UFMODBankManifest &Manifest);
+
+    /** Logs banks and sample data that failed to load in the background. */
+    void Update();
+
+    /** Forgets all banks without unloading them, for when the system that owns them is released. */
+    void Reset();
+
+private:
+    struct FBankEntry
+    {
+        FBankEntry()
+            : Bank(nullptr)
+            , RefCount(0)
+            , SampleDataRefCount(0)
+            , bOwned(false)
+            , bLoadPending(false)
+            , bSampleDataPending(false)
+        {
+        }
+
+        FString Name;
+        FMOD::Studio::Bank *Bank;
+        int32 RefCount;
+        int32 SampleDataRefCount;
+
+        /** True if the bank was loaded by the manager, and so should be unloaded by it. */
+        bool bOwned;
+
+        // True until the bank or its sample data has finished loading, so failures can be reported
+        bool bLoadPending;
+        bool bSampleDataPending;
+    };
+
+    TMap<FGuid, FBankEntry> Banks;
+};
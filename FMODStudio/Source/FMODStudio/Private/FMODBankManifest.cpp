@@ -0,0 +1,9 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#include "FMODBankManifest.h"
+
+UFMODBankManifest::UFMODBankManifest(const FObjectInitializer &ObjectInitializer)
+    : Super(ObjectInitializer)
+    , bLoadSampleData(false)
+{
+}
@@ -0,0 +1,35 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#include "FMODBankManifestComponent.h"
+#include "FMODBankManifest.h"
+#include "FMODStudioModule.h"
+
+UFMODBankManifestComponent::UFMODBankManifestComponent(const FObjectInitializer &ObjectInitializer)
+    : Super(ObjectInitializer)
+    , Manifest(nullptr)
+    , AcquiredManifest(nullptr)
+{
+    PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UFMODBankManifestComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (Manifest && IFMODStudioModule::IsAvailable())
+    {
+        AcquiredManifest = Manifest;
+        IFMODStudioModule::Get().AcquireBankManifest(AcquiredManifest);
+    }
+}
+
+void UFMODBankManifestComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (AcquiredManifest && IFMODStudioModule::IsAvailable())
+    {
+        IFMODStudioModule::Get().ReleaseBankManifest(AcquiredManifest);
+    }
+    AcquiredManifest = nullptr;
+
+    Super::EndPlay(EndPlayReason);
+}
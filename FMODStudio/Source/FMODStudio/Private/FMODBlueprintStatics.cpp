@@ -175,6 +175,7 @@ void UFMODBlueprintStatics::UnloadBank(class UFMODBank *Bank)
         if (result == FMOD_OK && bank != nullptr)
         {
             bank->unload();
+            IFMODStudioModule::Get().InvalidateEventDescriptions(EFMODSystemContext::Runtime);
         }
     }
 }
@@ -233,11 +234,7 @@ void UFMODBlueprintStatics::LoadEventSampleData(UObject *WorldContextObject, cla
 {
     if (IsValid(Event))
     {
-        FMOD::Studio::EventDescription *EventDesc = IFMODStudioModule::Get().GetEventDescription(Event);
-        if (EventDesc != nullptr)
-        {
-            EventDesc->loadSampleData();
-        }
+        IFMODStudioModule::Get().LoadEventSampleData(Event);
     }
 }
 
@@ -245,14 +242,20 @@ void UFMODBlueprintStatics::UnloadEventSampleData(UObject *WorldContextObject, c
 {
     if (IsValid(Event))
     {
-        FMOD::Studio::EventDescription *EventDesc = IFMODStudioModule::Get().GetEventDescription(Event);
-        if (EventDesc != nullptr)
-        {
-            EventDesc->unloadSampleData();
-        }
+        IFMODStudioModule::Get().UnloadEventSampleData(Event);
     }
 }
 
+void UFMODBlueprintStatics::PreloadProgrammerSounds(const TArray<FString> &Names)
+{
+    IFMODStudioModule::Get().PreloadProgrammerSounds(Names);
+}
+
+void UFMODBlueprintStatics::UnloadProgrammerSounds(const TArray<FString> &Names)
+{
+    IFMODStudioModule::Get().UnloadProgrammerSounds(Names);
+}
+
 TArray<FFMODEventInstance> UFMODBlueprintStatics::FindEventInstances(UObject *WorldContextObject, UFMODEvent *Event)
 {
     TArray<FFMODEventInstance> Instances;
@@ -0,0 +1,102 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#include "FMODEmitterManager.h"
+#include "FMODAudioComponent.h"
+#include "Engine/World.h"
+#include "Misc/App.h"
+#include "fmod_studio.hpp"
+#include "FMODStudioPrivatePCH.h"
+
+void FFMODEmitterManager::Register(UFMODAudioComponent *Component)
+{
+    if (Component->EmitterIndex != INDEX_NONE)
+    {
+        return;
+    }
+
+    Component->EmitterIndex = Components.Add(Component);
+}
+
+void FFMODEmitterManager::Unregister(UFMODAudioComponent *Component)
+{
+    const int32 Index = Component->EmitterIndex;
+    if (Index == INDEX_NONE)
+    {
+        return;
+    }
+
+    // Slots are only freed here; they are removed by the next Compact so indices stay stable during an update
+    Components[Index] = nullptr;
+    Component->EmitterIndex = INDEX_NONE;
+}
+
+void FFMODEmitterManager::Compact()
+{
+    for (int32 i = Components.Num() - 1; i >= 0; --i)
+    {
+        if (Components[i].IsValid())
+        {
+            continue;
+        }
+
+        Components.RemoveAtSwap(i, 1, false);
+
+        if (i < Components.Num())
+        {
+            Components[i]->EmitterIndex = i;
+        }
+    }
+}
+
+void FFMODEmitterManager::Update()
+{
+    if (Components.Num() == 0)
+    {
+        return;
+    }
+
+    Compact();
+
+    const double Now = FApp::GetCurrentTime();
+
+    // Components registered by callbacks during the update are appended and picked up next time
+    const int32 Count = Components.Num();
+    for (int32 i = 0; i < Count; ++i)
+    {
+        UFMODAudioComponent *Component = Components[i].Get();
+        if (!Component || !Component->IsActive())
+        {
+            continue;
+        }
+
+        UWorld *World = Component->GetWorld();
+        if (World && World->IsPaused())
+        {
+            continue;
+        }
+
+        // Components in the further distance bands are updated at their band's interval, as their tick function would be
+        if (Component->UpdateBandInterval > 0.0f && Now - Component->LastEmitterUpdateTime < Component->UpdateBandInterval)
+        {
+            continue;
+        }
+        Component->LastEmitterUpdateTime = Now;
+
+        FMOD_STUDIO_PLAYBACK_STATE State = FMOD_STUDIO_PLAYBACK_STOPPED;
+        if (Component->StudioInstance)
+        {
+            Component->TickEmitter();
+
+            // The instance may have been released by callbacks during TickEmitter
+            if (Component->StudioInstance)
+            {
+                Component->StudioInstance->getPlaybackState(&State);
+            }
+        }
+
+        if (State == FMOD_STUDIO_PLAYBACK_STOPPED)
+        {
+            Component->OnPlaybackCompleted();
+        }
+    }
+}
@@ -0,0 +1,29 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UFMODAudioComponent;
+
+/*
+    Updates playing audio components from the module tick instead of from a tick function per component, when
+    UFMODSettings::bUseEmitterManager is set. This only consolidates tick dispatch; each component is still updated on
+    the game thread in turn, as its tick function would have done.
+*/
+class FFMODEmitterManager
+{
+public:
+    void Register(UFMODAudioComponent *Component);
+    void Unregister(UFMODAudioComponent *Component);
+
+    void Update();
+
+private:
+    /** Removes the slots of unregistered and destroyed components, fixing up the indices of the ones moved. */
+    void Compact();
+
+    /** Registered components, indexed by their EmitterIndex */
+    TArray<TWeakObjectPtr<UFMODAudioComponent>> Components;
+};
@@ -0,0 +1,180 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#include "FMODEventInstancePool.h"
+#include "FMODUtils.h"
+#include "fmod_studio.hpp"
+#include "FMODStudioPrivatePCH.h"
+
+FFMODEventInstancePool::FFMODEventInstancePool()
+    : PoolSize(0)
+    , WarmSize(0)
+{
+}
+
+void FFMODEventInstancePool::SetPoolSize(int32 InPoolSize, int32 InWarmSize)
+{
+    PoolSize = FMath::Max(InPoolSize, 0);
+    WarmSize = FMath::Clamp(InWarmSize, 0, PoolSize);
+}
+
+FMOD::Studio::EventInstance *FFMODEventInstancePool::Acquire(FMOD::Studio::EventDescription *EventDesc)
+{
+    FMOD::Studio::EventInstance *Instance = nullptr;
+
+    if (PoolSize > 0)
+    {
+        FPool &Pool = FindOrAddPool(EventDesc);
+        while (Pool.Idle.Num() > 0)
+        {
+            Instance = Pool.Idle.Pop(false);
+            if (Instance->isValid())
+            {
+                return Instance;
+            }
+        }
+    }
+
+    Instance = nullptr;
+    EventDesc->createInstance(&Instance);
+    return Instance;
+}
+
+void FFMODEventInstancePool::Release(FMOD::Studio::EventInstance *Instance)
+{
+    if (PoolSize > 0)
+    {
+        Stopping.Add(Instance);
+    }
+    else
+    {
+        Instance->release();
+    }
+}
+
+void FFMODEventInstancePool::Update()
+{
+    for (int32 i = Stopping.Num() - 1; i >= 0; --i)
+    {
+        FMOD::Studio::EventInstance *Instance = Stopping[i];
+
+        FMOD_STUDIO_PLAYBACK_STATE State = FMOD_STUDIO_PLAYBACK_STOPPED;
+        FMOD::Studio::EventDescription *EventDesc = nullptr;
+        if (Instance->getPlaybackState(&State) != FMOD_OK || Instance->getDescription(&EventDesc) != FMOD_OK)
+        {
+            // Destroyed along with its bank
+            Stopping.RemoveAtSwap(i);
+            continue;
+        }
+
+        if (State != FMOD_STUDIO_PLAYBACK_STOPPED)
+        {
+            continue;
+        }
+
+        Stopping.RemoveAtSwap(i);
+
+        FPool &Pool = FindOrAddPool(EventDesc);
+        if (Pool.Idle.Num() < PoolSize)
+        {
+            Reset(Instance, Pool);
+            Pool.Idle.Add(Instance);
+        }
+        else
+        {
+            Instance->release();
+        }
+    }
+}
+
+int32 FFMODEventInstancePool::GetIdleCount(FMOD::Studio::EventDescription *EventDesc) const
+{
+    const FPool *Pool = Pools.Find(EventDesc);
+    return Pool ? Pool->Idle.Num() : 0;
+}
+
+void FFMODEventInstancePool::ReleaseIdle(FMOD::Studio::EventDescription *EventDesc)
+{
+    FPool *Pool = Pools.Find(EventDesc);
+    if (!Pool)
+    {
+        return;
+    }
+
+    for (FMOD::Studio::EventInstance *Instance : Pool->Idle)
+    {
+        Instance->release();
+    }
+    Pool->Idle.Reset();
+}
+
+void FFMODEventInstancePool::ReleaseInvalid()
+{
+    // Instances of unloaded events were destroyed with their bank, so there is nothing to release
+    for (auto It = Pools.CreateIterator(); It; ++It)
+    {
+        if (!It.Key()->isValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    Stopping.RemoveAllSwap([](FMOD::Studio::EventInstance *Instance) { return !Instance->isValid(); });
+}
+
+FFMODEventInstancePool::FPool &FFMODEventInstancePool::FindOrAddPool(FMOD::Studio::EventDescription *EventDesc)
+{
+    FPool *Pool = Pools.Find(EventDesc);
+    if (Pool)
+    {
+        return *Pool;
+    }
+
+    Pool = &Pools.Add(EventDesc);
+
+    int ParameterCount = 0;
+    EventDesc->getParameterDescriptionCount(&ParameterCount);
+    for (int i = 0; i < ParameterCount; ++i)
+    {
+        FMOD_STUDIO_PARAMETER_DESCRIPTION ParameterDesc = {};
+        const FMOD_STUDIO_PARAMETER_FLAGS NotSettable = FMOD_STUDIO_PARAMETER_READONLY | FMOD_STUDIO_PARAMETER_AUTOMATIC | FMOD_STUDIO_PARAMETER_GLOBAL;
+        if (EventDesc->getParameterDescriptionByIndex(i, &ParameterDesc) == FMOD_OK && !(ParameterDesc.flags & NotSettable))
+        {
+            Pool->ParameterIds.Add(ParameterDesc.id);
+            Pool->DefaultValues.Add(ParameterDesc.defaultvalue);
+        }
+    }
+
+    // Warm the pool so the first plays don't create instances either
+    Pool->Idle.Reserve(WarmSize);
+    for (int32 i = 0; i < WarmSize; ++i)
+    {
+        FMOD::Studio::EventInstance *Instance = nullptr;
+        if (EventDesc->createInstance(&Instance) != FMOD_OK)
+        {
+            break;
+        }
+        Pool->Idle.Add(Instance);
+    }
+
+    return *Pool;
+}
+
+void FFMODEventInstancePool::Reset(FMOD::Studio::EventInstance *Instance, FPool &Pool)
+{
+    Instance->setCallback(nullptr);
+    Instance->setUserData(nullptr);
+    Instance->setPaused(false);
+    Instance->setVolume(1.0f);
+    Instance->setPitch(1.0f);
+
+    // Setting a property to -1 restores the value from FMOD Studio
+    for (int i = 0; i < FMOD_STUDIO_EVENT_PROPERTY_MAX; ++i)
+    {
+        Instance->setProperty((FMOD_STUDIO_EVENT_PROPERTY)i, -1.0f);
+    }
+
+    if (Pool.ParameterIds.Num() > 0)
+    {
+        Instance->setParametersByIDs(Pool.ParameterIds.GetData(), Pool.DefaultValues.GetData(), Pool.ParameterIds.Num(), true);
+    }
+}
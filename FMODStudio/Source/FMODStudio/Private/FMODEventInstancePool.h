@@ -0,0 +1,70 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "fmod_studio_common.h"
+
+namespace FMOD
+{
+namespace Studio
+{
+class EventDescription;
+class EventInstance;
+}
+}
+
+/*
+    Reuses event instances instead of creating and releasing one for every play. Released instances are kept until they
+    stop, then reset to their default parameter values and properties and kept for the next Acquire of the same event,
+    up to the pool size per event. The first Acquire of an event creates the warm size of instances up front. With a
+    pool size of 0 instances are created and released as normal.
+
+    Idle instances keep their event's sample data loaded, so FFMODSampleDataManager releases them with ReleaseIdle
+    before unloading it.
+*/
+class FFMODEventInstancePool
+{
+public:
+    FFMODEventInstancePool();
+
+    void SetPoolSize(int32 InPoolSize, int32 InWarmSize);
+
+    /** Returns a stopped instance of the event, or null if one couldn't be created. */
+    FMOD::Studio::EventInstance *Acquire(FMOD::Studio::EventDescription *EventDesc);
+
+    /** Returns an instance to the pool once it has stopped. It may still be playing. */
+    void Release(FMOD::Studio::EventInstance *Instance);
+
+    void Update();
+
+    /** Returns the number of idle instances pooled for an event. */
+    int32 GetIdleCount(FMOD::Studio::EventDescription *EventDesc) const;
+
+    /** Releases the idle instances of an event, so they don't keep its sample data loaded. */
+    void ReleaseIdle(FMOD::Studio::EventDescription *EventDesc);
+
+    /** Forgets the pools and stopping instances of events that have been unloaded. */
+    void ReleaseInvalid();
+
+private:
+    struct FPool
+    {
+        TArray<FMOD::Studio::EventInstance *> Idle;
+
+        /** Default values of the event's settable parameters, applied when an instance is reused. */
+        TArray<FMOD_STUDIO_PARAMETER_ID> ParameterIds;
+        TArray<float> DefaultValues;
+    };
+
+    FPool &FindOrAddPool(FMOD::Studio::EventDescription *EventDesc);
+    void Reset(FMOD::Studio::EventInstance *Instance, FPool &Pool);
+
+    TMap<FMOD::Studio::EventDescription *, FPool> Pools;
+
+    /** Instances released to the pool that haven't stopped yet. */
+    TArray<FMOD::Studio::EventInstance *> Stopping;
+
+    int32 PoolSize;
+    int32 WarmSize;
+};
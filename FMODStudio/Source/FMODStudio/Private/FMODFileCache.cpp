@@ -0,0 +1,198 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#include "FMODFileCache.h"
+#include "Misc/ScopeLock.h"
+#include "FMODStudioPrivatePCH.h"
+
+// Blocks are allocated on page boundaries so they can be filled by unbuffered platform reads
+static const uint32 FMOD_FILE_CACHE_ALIGNMENT = 4096;
+
+FFMODFileCache::FFMODFileCache()
+    : BudgetBytes(0)
+    , BlockSize(64 * 1024)
+    , UsedBytes(0)
+    , Head(nullptr)
+    , Tail(nullptr)
+    , NextFileId(1)
+{
+}
+
+FFMODFileCache::~FFMODFileCache()
+{
+    RemoveAll();
+}
+
+void FFMODFileCache::Configure(int64 InBudgetBytes, int32 InBlockSize)
+{
+    FScopeLock lock(&Crit);
+
+    RemoveAll();
+    BudgetBytes = FMath::Max(InBudgetBytes, (int64)0);
+    BlockSize = FMath::RoundUpToPowerOfTwo(FMath::Max(InBlockSize, (int32)FMOD_FILE_CACHE_ALIGNMENT));
+
+    UE_LOG(LogFMOD, Log, TEXT("FMOD file cache: budget %lld bytes, block size %d bytes"), BudgetBytes, BlockSize);
+}
+
+uint32 FFMODFileCache::AcquireFile(const FString &Name, int64 FileSize, const FDateTime &TimeStamp)
+{
+    FScopeLock lock(&Crit);
+
+    for (TPair<uint32, FFileEntry> &Pair : Files)
+    {
+        FFileEntry &Entry = Pair.Value;
+        if (Entry.FileSize == FileSize && Entry.TimeStamp == TimeStamp && Entry.Name == Name)
+        {
+            ++Entry.RefCount;
+            return Pair.Key;
+        }
+    }
+
+    uint32 FileId = NextFileId++;
+    FFileEntry &Entry = Files.Add(FileId);
+    Entry.Name = Name;
+    Entry.FileSize = FileSize;
+    Entry.TimeStamp = TimeStamp;
+    Entry.RefCount = 1;
+    Entry.BlockCount = 0;
+    return FileId;
+}
+
+void FFMODFileCache::ReleaseFile(uint32 FileId)
+{
+    FScopeLock lock(&Crit);
+
+    FFileEntry *Entry = Files.Find(FileId);
+    if (Entry && --Entry->RefCount == 0 && Entry->BlockCount == 0)
+    {
+        Files.Remove(FileId);
+    }
+}
+
+bool FFMODFileCache::Read(uint32 FileId, int64 BlockIndex, int32 OffsetInBlock, int32 Size, void *Dest)
+{
+    FScopeLock lock(&Crit);
+
+    FBlock **Found = Blocks.Find(MakeKey(FileId, BlockIndex));
+    if (!Found || OffsetInBlock + Size > (*Found)->Size)
+    {
+        return false;
+    }
+
+    FBlock *Block = *Found;
+    FMemory::Memcpy(Dest, Block->Data + OffsetInBlock, Size);
+
+    Unlink(Block);
+    LinkAtHead(Block);
+    return true;
+}
+
+bool FFMODFileCache::Contains(uint32 FileId, int64 BlockIndex)
+{
+    FScopeLock lock(&Crit);
+
+    return Blocks.Contains(MakeKey(FileId, BlockIndex));
+}
+
+void FFMODFileCache::Insert(uint32 FileId, int64 BlockIndex, const void *Data, int32 Size)
+{
+    FScopeLock lock(&Crit);
+
+    if (!IsEnabled() || Size <= 0 || Size > BlockSize || !Files.Contains(FileId))
+    {
+        return;
+    }
+
+    uint64 Key = MakeKey(FileId, BlockIndex);
+    if (Blocks.Contains(Key))
+    {
+        // Another handle read the same block concurrently
+        return;
+    }
+
+    while (Tail && UsedBytes + BlockSize > BudgetBytes)
+    {
+        Remove(Tail);
+    }
+
+    if (UsedBytes + BlockSize > BudgetBytes)
+    {
+        return;
+    }
+
+    FBlock *Block = new FBlock;
+    Block->FileId = FileId;
+    Block->BlockIndex = BlockIndex;
+    Block->Data = (uint8 *)FMemory::Malloc(BlockSize, FMOD_FILE_CACHE_ALIGNMENT);
+    Block->Size = Size;
+    FMemory::Memcpy(Block->Data, Data, Size);
+
+    Blocks.Add(Key, Block);
+    LinkAtHead(Block);
+    UsedBytes += BlockSize;
+    ++Files[FileId].BlockCount;
+}
+
+void FFMODFileCache::Unlink(FBlock *Block)
+{
+    if (Block->Prev)
+    {
+        Block->Prev->Next = Block->Next;
+    }
+    else
+    {
+        Head = Block->Next;
+    }
+
+    if (Block->Next)
+    {
+        Block->Next->Prev = Block->Prev;
+    }
+    else
+    {
+        Tail = Block->Prev;
+    }
+
+    Block->Prev = nullptr;
+    Block->Next = nullptr;
+}
+
+void FFMODFileCache::LinkAtHead(FBlock *Block)
+{
+    Block->Prev = nullptr;
+    Block->Next = Head;
+    if (Head)
+    {
+        Head->Prev = Block;
+    }
+    Head = Block;
+    if (!Tail)
+    {
+        Tail = Block;
+    }
+}
+
+void FFMODFileCache::Remove(FBlock *Block)
+{
+    Unlink(Block);
+    Blocks.Remove(MakeKey(Block->FileId, Block->BlockIndex));
+    UsedBytes -= BlockSize;
+
+    // Forget closed files once the last of their blocks is evicted
+    FFileEntry &Entry = Files[Block->FileId];
+    if (--Entry.BlockCount == 0 && Entry.RefCount == 0)
+    {
+        Files.Remove(Block->FileId);
+    }
+
+    FMemory::Free(Block->Data);
+    delete Block;
+}
+
+void FFMODFileCache::RemoveAll()
+{
+    while (Head)
+    {
+        Remove(Head);
+    }
+    check(Blocks.Num() == 0 && UsedBytes == 0);
+}
@@ -0,0 +1,83 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+/*
+    Cache of fixed size, aligned blocks of file data shared between all FMOD file handles. Blocks are keyed by file
+    contents (path, size and timestamp) so that handles opened on the same bank share them, including handles opened after
+    the previous ones closed, e.g. a stream that is replayed. When the byte budget is exceeded the least recently used
+    blocks are evicted.
+*/
+class FFMODFileCache
+{
+public:
+    FFMODFileCache();
+    ~FFMODFileCache();
+
+    /** Sets the byte budget and block size, discarding any cached blocks. A budget of 0 disables the cache. */
+    void Configure(int64 InBudgetBytes, int32 InBlockSize);
+
+    bool IsEnabled() const { return BudgetBytes > 0; }
+    int32 GetBlockSize() const { return BlockSize; }
+
+    /** Returns an identifier shared by every open handle to the same file contents. */
+    uint32 AcquireFile(const FString &Name, int64 FileSize, const FDateTime &TimeStamp);
+
+    /** Releases a file identifier. Its blocks stay cached for the next handle to the same file until they are evicted. */
+    void ReleaseFile(uint32 FileId);
+
+    /** Copies Size bytes starting at OffsetInBlock out of a cached block. Returns false if the block is not cached. */
+    bool Read(uint32 FileId, int64 BlockIndex, int32 OffsetInBlock, int32 Size, void *Dest);
+
+    bool Contains(uint32 FileId, int64 BlockIndex);
+
+    /** Adds a block read from disk. Size may be less than the block size for the last block of a file. */
+    void Insert(uint32 FileId, int64 BlockIndex, const void *Data, int32 Size);
+
+private:
+    struct FBlock
+    {
+        uint32 FileId;
+        int64 BlockIndex;
+        uint8 *Data;
+        int32 Size;
+
+        // Least recently used list, Head is the most recently used
+        FBlock *Prev;
+        FBlock *Next;
+    };
+
+    struct FFileEntry
+    {
+        FString Name;
+        int64 FileSize;
+        FDateTime TimeStamp;
+        int32 RefCount;
+
+        /** Number of cached blocks, the entry is kept while there are any so reopening the file finds them. */
+        int32 BlockCount;
+    };
+
+    static uint64 MakeKey(uint32 FileId, int64 BlockIndex) { return ((uint64)FileId << 40) | (uint64)BlockIndex; }
+
+    void Unlink(FBlock *Block);
+    void LinkAtHead(FBlock *Block);
+    void Remove(FBlock *Block);
+    void RemoveAll();
+
+    int64 BudgetBytes;
+    int32 BlockSize;
+    int64 UsedBytes;
+
+    TMap<uint64, FBlock *> Blocks;
+    FBlock *Head;
+    FBlock *Tail;
+
+    TMap<uint32, FFileEntry> Files;
+    uint32 NextFileId;
+
+    FCriticalSection Crit;
+};
@@ -1,13 +1,26 @@
 // Copyright (c), Firelight Technologies Pty, Ltd. 2012-2015.
 
 #include "FMODFileCallbacks.h"
+#include "FMODFileCache.h"
+#include "FMODFileStats.h"
+#include "FMODFileTrace.h"
 #include "fmod_errors.h"
 #include "FMODUtils.h"
+#include "FMODSettings.h"
 #include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/AsyncFileHandle.h"
 #include "GenericPlatform/GenericPlatformProcess.h"
 #include "HAL/Runnable.h"
 #include "HAL/RunnableThread.h"
 #include "Misc/ScopeLock.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
 #include "FMODStudioPrivatePCH.h"
 
 FMOD_RESULT F_CALLBACK FMODLogCallback(FMOD_DEBUG_FLAGS flags, const char *file, int line, const char *func, const char *message)
@@ -59,190 +72,634 @@ FMOD_RESULT F_CALLBACK FMODErrorCallback(FMOD_SYSTEM *system, FMOD_SYSTEM_CALLBA
     return FMOD_OK;
 }
 
-class FFMODFileSystem : public FRunnable
+/*
+    All file access happens on threads owned by the file system rather than on FMOD's own threads, since some Unreal file
+    backends (e.g. compressed pak files) need more stack than FMOD threads provide. Reads are issued through FMOD's
+    asynchronous read callbacks and serviced by a pool of workers in priority order, so several reads can be in flight at once.
+    One worker only services high priority reads (streams) so that they never wait behind bulk loads such as sample data.
+
+    Optionally, files which the platform can memory map (loose files on disk and uncompressed pak entries) are mapped once
+    when opened and reads are copied straight out of the mapping. The copy still goes through the workers, since touching
+    pages of the mapping that aren't resident faults them in from disk.
+
+    Other files are read either through an FArchive or, optionally, through the platform's asynchronous read handles so
+    that bank reads are scheduled by the engine (and pak/IoStore layers) alongside its own streaming, with stream reads at
+    high priority. Reads on these files can go through a shared block cache. When a handle reads sequentially (e.g. a stream) the
+    following blocks are read ahead at the lowest priority, so that later reads are served from memory.
+*/
+
+struct FFMODFileHandle
+{
+    FFMODFileHandle(const FString &InName, int64 InFileSize)
+        : Name(InName)
+        , FileSize(InFileSize)
+        , Archive(nullptr)
+        , AsyncHandle(nullptr)
+        , MappedFile(nullptr)
+        , MappedRegion(nullptr)
+        , CacheFileId(0)
+        , NextSequentialOffset(0)
+        , ReadAheadEndBlock(0)
+        , FilePosition(0)
+        , TraceId(0)
+    {
+    }
+
+    FString Name;
+    int64 FileSize;
+
+    // Exactly one of Archive, AsyncHandle or MappedRegion is set, depending on how the file was opened
+    FArchive *Archive;
+    IAsyncReadFileHandle *AsyncHandle;
+    IMappedFileHandle *MappedFile;
+    IMappedFileRegion *MappedRegion;
+
+    /** Identifies the file in the block cache, or 0 if reads bypass the cache. */
+    uint32 CacheFileId;
+
+    // Read state used with the block cache, protected by Lock
+    TArray<uint8 *> BlockBuffers;
+    int64 NextSequentialOffset;
+    int64 ReadAheadEndBlock;
+
+    /** Where the last read from the underlying file ended, to count seeks. */
+    int64 FilePosition;
+
+    /** Identifies the file in the trace being recorded, or 0 if not recording. */
+    uint32 TraceId;
+
+    /**
+     * Protects the read state and serializes access to the archive, which can only do one read at a time. Reads through a
+     * mapping, an async handle or the block cache only take it briefly, so several reads of one handle run concurrently.
+     */
+    FCriticalSection Lock;
+
+    /** Returns a buffer for reading one cache block, so concurrent block reads don't share one. */
+    uint8 *AcquireBlockBuffer(int32 BlockSize)
+    {
+        {
+            FScopeLock lock(&Lock);
+            if (BlockBuffers.Num() > 0)
+            {
+                return BlockBuffers.Pop(false);
+            }
+        }
+        return (uint8 *)FMemory::Malloc(BlockSize, 4096);
+    }
+
+    void ReleaseBlockBuffer(uint8 *Buffer)
+    {
+        FScopeLock lock(&Lock);
+        BlockBuffers.Push(Buffer);
+    }
+};
+
+struct FFMODFileRequest
+{
+    enum Type
+    {
+        TYPE_OPEN,
+        TYPE_CLOSE,
+        TYPE_READ,
+        TYPE_READ_AHEAD,
+    };
+
+    FFMODFileRequest(Type InType, int InPriority)
+        : RequestType(InType)
+        , Priority(InPriority)
+        , Sequence(0)
+        , Name(nullptr)
+        , FileSize(nullptr)
+        , HandleOut(nullptr)
+        , HandleIn(nullptr)
+        , BlockIndex(0)
+        , ReadInfo(nullptr)
+        , CompleteEvent(nullptr)
+        , DoneEvent(nullptr)
+        , Result(FMOD_OK)
+        , EnqueueTime(0)
+        , StartTime(0)
+    {
+    }
+
+    bool IsServicedBefore(const FFMODFileRequest &Other) const
+    {
+        // Highest priority first, then first come first served
+        return (Priority != Other.Priority) ? (Priority > Other.Priority) : (Sequence < Other.Sequence);
+    }
+
+    Type RequestType;
+    int Priority;
+    uint64 Sequence;
+
+    // Parameters for Open
+    const char *Name;
+    unsigned int *FileSize;
+    void **HandleOut;
+
+    // Parameter for Close and ReadAhead
+    void *HandleIn;
+    int64 BlockIndex;
+
+    // Parameter for Read
+    FMOD_ASYNCREADINFO *ReadInfo;
+
+    // Open and Close are synchronous, the calling thread waits on this event
+    FEvent *CompleteEvent;
+    FMOD_RESULT Result;
+
+    // Set while the request is in flight by a thread waiting for it to finish, e.g. to cancel it
+    FEvent *DoneEvent;
+
+    // For statistics
+    double EnqueueTime;
+    double StartTime;
+};
+
+class FFMODFileSystem
 {
 public:
+    // FMOD priorities range from 0 (low importance) to 100 (extreme importance, i.e. a stream about to starve)
+    static const int PRIORITY_MAX = 100;
+    static const int PRIORITY_HIGH = 50;
+    static const int PRIORITY_READ_AHEAD = 0;
+
     FFMODFileSystem()
-        : mHandleIn(nullptr)
-        , mName(nullptr)
-        , mFileSize(nullptr)
-        , mHandleOut(nullptr)
-        , mBuffer(nullptr)
-        , mSizeBytes(0)
-        , mBytesRead(nullptr)
-        , mSeekPosition(0)
-        , mCommand(COMMAND_MAX)
-        , mResult(FMOD_OK)
-        , mReferenceCount(0)
-        , mThread(nullptr)
-        , mCommandReadyEvent(nullptr)
-        , mCommandCompleteEvent(nullptr)
+        : mReferenceCount(0)
+        , mMemoryMapFiles(false)
+        , mUseAsyncReadHandles(false)
+        , mReadAheadBlocks(0)
+        , mNextSequence(0)
+        , mStopping(false)
     {
     }
 
     static FMOD_RESULT F_CALLBACK OpenCallback(const char *name, unsigned int *filesize, void **handle, void * /*userdata*/);
     static FMOD_RESULT F_CALLBACK CloseCallback(void *handle, void * /*userdata*/);
-    static FMOD_RESULT F_CALLBACK ReadCallback(void *handle, void *buffer, unsigned int sizebytes, unsigned int *bytesread, void * /*userdata*/);
-    static FMOD_RESULT F_CALLBACK SeekCallback(void *handle, unsigned int pos, void * /*userdata*/);
+    static FMOD_RESULT F_CALLBACK AsyncReadCallback(FMOD_ASYNCREADINFO *info, void * /*userdata*/);
+    static FMOD_RESULT F_CALLBACK AsyncCancelCallback(FMOD_ASYNCREADINFO *info, void * /*userdata*/);
 
     static FMOD_RESULT OpenInternal(const char *name, unsigned int *filesize, void **handle);
     static FMOD_RESULT CloseInternal(void *handle);
-    static FMOD_RESULT ReadInternal(void *handle, void *buffer, unsigned int sizebytes, unsigned int *bytesread);
-    static FMOD_RESULT SeekInternal(void *handle, unsigned int pos);
+    static FMOD_RESULT ReadInternal(void *handle, void *buffer, unsigned int offset, unsigned int sizebytes, unsigned int *bytesread, EAsyncIOPriorityAndFlags ioPriority);
+    static FMOD_RESULT ReadMapped(FFMODFileHandle *handle, void *buffer, unsigned int offset, unsigned int sizebytes, unsigned int *bytesread);
+    static FMOD_RESULT ReadCached(FFMODFileHandle *handle, void *buffer, unsigned int offset, unsigned int sizebytes, unsigned int *bytesread, EAsyncIOPriorityAndFlags ioPriority);
+    static bool ReadBlock(FFMODFileHandle *handle, int64 blockIndex, int32 offsetInBlock, int32 size, void *dest, EAsyncIOPriorityAndFlags ioPriority);
+    static bool ReadFromFile(FFMODFileHandle *handle, int64 offset, int64 size, void *dest, EAsyncIOPriorityAndFlags ioPriority);
+
+    static EAsyncIOPriorityAndFlags GetIOPriority(int priority)
+    {
+        // Streams about to starve compete with the engine's own high priority streaming, everything else is routine
+        return (priority >= PRIORITY_HIGH) ? AIOP_High : AIOP_Normal;
+    }
 
-    void IncrementReferenceCount()
+    void IncrementReferenceCount(const UFMODSettings &Settings)
     {
-        FScopeLock lock(&mCrit);
+        FScopeLock lock(&mLifetimeCrit);
 
         ++mReferenceCount;
 
         if (mReferenceCount == 1)
         {
-            check(!mThread);
+            StartWorkers(Settings);
 
-            mCommandReadyEvent = FGenericPlatformProcess::GetSynchEventFromPool();
-            mCommandCompleteEvent = FGenericPlatformProcess::GetSynchEventFromPool();
-            mThread = FRunnableThread::Create(this, TEXT("FMOD File Access Coordinator"));
+            FString TracePath;
+            if (FParse::Value(FCommandLine::Get(), TEXT("FMODFileTrace="), TracePath) || FParse::Param(FCommandLine::Get(), TEXT("FMODFileTrace")))
+            {
+                if (TracePath.IsEmpty())
+                {
+                    TracePath = FPaths::ProfilingDir() / TEXT("FMODFileTrace.bin");
+                }
+                mTrace.Start(TracePath, Settings.FileBufferSize);
+            }
         }
     }
 
     void DecrementReferenceCount()
     {
-        FScopeLock lock(&mCrit);
+        FScopeLock lock(&mLifetimeCrit);
 
         check(mReferenceCount > 0);
-        check(mThread);
 
         --mReferenceCount;
 
         if (mReferenceCount == 0)
         {
-            verifyfmod(RunCommand(COMMAND_STOP));
-            mThread->WaitForCompletion();
-
-            FGenericPlatformProcess::ReturnSynchEventToPool(mCommandReadyEvent);
-            mCommandReadyEvent = nullptr;
-            FGenericPlatformProcess::ReturnSynchEventToPool(mCommandCompleteEvent);
-            mCommandCompleteEvent = nullptr;
-            delete mThread;
-            mThread = nullptr;
+            StopWorkers();
+            mTrace.Stop();
         }
     }
 
+    bool Replay(const FFMODFileTrace &Trace, const UFMODSettings &Settings, bool bRealTime, FOutputDevice &Ar);
+
     void Attach(FMOD::System *system, int32 fileBufferSize)
     {
-        check(mThread);
+        check(mWorkers.Num() > 0);
 
-        verifyfmod(system->setFileSystem(OpenCallback, CloseCallback, ReadCallback, SeekCallback, 0, 0, fileBufferSize));
+        verifyfmod(system->setFileSystem(OpenCallback, CloseCallback, nullptr, nullptr, AsyncReadCallback, AsyncCancelCallback, fileBufferSize));
     }
 
-    uint32 Run() override
+    FFMODFileStats &GetStats() { return mStats; }
+
+private:
+    void StartWorkers(const UFMODSettings &Settings)
     {
-        bool stopRequested = false;
+        check(mWorkers.Num() == 0);
+
+        mStopping = false;
+        mMemoryMapFiles = Settings.bMemoryMapBankFiles;
+        mUseAsyncReadHandles = Settings.bUseAsyncFileReadHandles;
+        mReadAheadBlocks = FMath::Max(Settings.FileReadAheadBlocks, 0);
+        mCache.Configure(Settings.FileCacheSize, Settings.FileCacheBlockSize);
+        mWorkers.Add(new FWorker(*this, PRIORITY_HIGH, TEXT("FMOD File Stream Worker"), TPri_AboveNormal));
 
-        while (!stopRequested)
+        int32 ThreadCount = FMath::Max(Settings.FileThreadCount, 1);
+        for (int32 i = 0; i < ThreadCount; ++i)
         {
-            mCommandReadyEvent->Wait();
+            mWorkers.Add(new FWorker(*this, 0, *FString::Printf(TEXT("FMOD File Worker %d"), i), TPri_Normal));
+        }
+    }
+
+    void StopWorkers()
+    {
+        check(mWorkers.Num() > 0);
 
-            switch (mCommand)
+        {
+            FScopeLock queueLock(&mQueueCrit);
+            mStopping = true;
+        }
+
+        for (FWorker *Worker : mWorkers)
+        {
+            Worker->mWakeEvent->Trigger();
+        }
+        for (FWorker *Worker : mWorkers)
+        {
+            delete Worker;
+        }
+        mWorkers.Reset();
+        mIdleWorkers.Reset();
+
+        check(mPending.Num() == 0 && mInFlight.Num() == 0);
+    }
+
+    void OnOpened(FFMODFileHandle *FileHandle)
+    {
+        mOpenHandles.Increment();
+        mStats.RecordOpen(FileHandle->Name);
+        FileHandle->TraceId = mTrace.RecordOpen(FileHandle->Name, (uint32)FileHandle->FileSize);
+    }
+
+    class FWorker : public FRunnable
+    {
+    public:
+        FWorker(FFMODFileSystem &FileSystem, int MinPriority, const TCHAR *ThreadName, EThreadPriority ThreadPriority)
+            : mFileSystem(FileSystem)
+            , mMinPriority(MinPriority)
+            , mWakeEvent(FGenericPlatformProcess::GetSynchEventFromPool())
+            , mThread(nullptr)
+        {
+            mThread = FRunnableThread::Create(this, ThreadName, 0, ThreadPriority);
+        }
+
+        ~FWorker()
+        {
+            mThread->WaitForCompletion();
+            delete mThread;
+            FGenericPlatformProcess::ReturnSynchEventToPool(mWakeEvent);
+        }
+
+        uint32 Run() override
+        {
+            while (FFMODFileRequest *Request = mFileSystem.WaitForRequest(*this))
             {
-                case COMMAND_OPEN:
-                    mResult = OpenInternal(mName, mFileSize, mHandleOut);
-                    break;
-                case COMMAND_CLOSE:
-                    mResult = CloseInternal(mHandleIn);
-                    break;
-                case COMMAND_READ:
-                    mResult = ReadInternal(mHandleIn, mBuffer, mSizeBytes, mBytesRead);
-                    break;
-                case COMMAND_SEEK:
-                    mResult = SeekInternal(mHandleIn, mSeekPosition);
-                    break;
-                case COMMAND_STOP:
-                    stopRequested = true;
-                    mResult = FMOD_OK;
-                    break;
+                mFileSystem.Process(Request);
             }
 
-            mCommandCompleteEvent->Trigger();
+            return 0;
         }
 
-        return 0;
-    }
+        FFMODFileSystem &mFileSystem;
 
-private:
-    enum Command
-    {
-        COMMAND_OPEN,
-        COMMAND_CLOSE,
-        COMMAND_READ,
-        COMMAND_SEEK,
-        COMMAND_STOP,
-        COMMAND_MAX,
+        // Only requests at or above this priority are serviced by this worker
+        int mMinPriority;
+
+        FEvent *mWakeEvent;
+        FRunnableThread *mThread;
     };
 
-    FMOD_RESULT RunCommand(Command command)
+    void Enqueue(FFMODFileRequest *Request)
+    {
+        FScopeLock lock(&mQueueCrit);
+        Request->Sequence = mNextSequence++;
+        Request->EnqueueTime = FPlatformTime::Seconds();
+        mPending.Add(Request);
+        WakeWorker(Request->Priority);
+    }
+
+    /**
+     * Wakes one idle worker that can service a request of the given priority, preferring the stream worker for high
+     * priority requests so the other workers stay free for bulk reads. Called with mQueueCrit held.
+     */
+    void WakeWorker(int Priority)
+    {
+        int32 BestIndex = INDEX_NONE;
+        for (int32 i = 0; i < mIdleWorkers.Num(); ++i)
+        {
+            const FWorker *Candidate = mIdleWorkers[i];
+            if (Candidate->mMinPriority <= Priority && (BestIndex == INDEX_NONE || Candidate->mMinPriority > mIdleWorkers[BestIndex]->mMinPriority))
+            {
+                BestIndex = i;
+            }
+        }
+
+        if (BestIndex != INDEX_NONE)
+        {
+            FWorker *Worker = mIdleWorkers[BestIndex];
+            mIdleWorkers.RemoveAtSwap(BestIndex, 1, false);
+            Worker->mWakeEvent->Trigger();
+        }
+    }
+
+    FMOD_RESULT RunSynchronous(FFMODFileRequest &Request)
     {
-        check(mThread);
+        Request.CompleteEvent = FGenericPlatformProcess::GetSynchEventFromPool();
+        Enqueue(&Request);
+        Request.CompleteEvent->Wait();
+        FGenericPlatformProcess::ReturnSynchEventToPool(Request.CompleteEvent);
+        Request.CompleteEvent = nullptr;
+
+        return Request.Result;
+    }
 
-        mCommand = command;
-        mCommandReadyEvent->Trigger();
-        mCommandCompleteEvent->Wait();
+    FFMODFileRequest *WaitForRequest(FWorker &Worker)
+    {
+        for (;;)
+        {
+            {
+                FScopeLock lock(&mQueueCrit);
+
+                int32 BestIndex = INDEX_NONE;
+                for (int32 i = 0; i < mPending.Num(); ++i)
+                {
+                    const FFMODFileRequest *Candidate = mPending[i];
+                    if (Candidate->Priority >= Worker.mMinPriority && (BestIndex == INDEX_NONE || Candidate->IsServicedBefore(*mPending[BestIndex])))
+                    {
+                        BestIndex = i;
+                    }
+                }
+
+                if (BestIndex != INDEX_NONE)
+                {
+                    FFMODFileRequest *Request = mPending[BestIndex];
+                    mPending.RemoveAtSwap(BestIndex, 1, false);
+                    mInFlight.Add(Request);
+                    Request->StartTime = FPlatformTime::Seconds();
+
+                    // This worker may have been woken for a different request than the one it took
+                    int HighestPending = -1;
+                    for (const FFMODFileRequest *Pending : mPending)
+                    {
+                        HighestPending = FMath::Max(HighestPending, Pending->Priority);
+                    }
+                    if (HighestPending >= 0)
+                    {
+                        WakeWorker(HighestPending);
+                    }
+                    return Request;
+                }
+
+                if (mStopping)
+                {
+                    return nullptr;
+                }
+
+                // Enqueue removes the worker from the idle list when it wakes it
+                mIdleWorkers.AddUnique(&Worker);
+            }
 
-        return mResult;
+            Worker.mWakeEvent->Wait();
+        }
     }
 
-    // Parameter for Close, Seek and Read
-    void *mHandleIn;
+    void Process(FFMODFileRequest *Request)
+    {
+        switch (Request->RequestType)
+        {
+            case FFMODFileRequest::TYPE_OPEN:
+                Request->Result = OpenInternal(Request->Name, Request->FileSize, Request->HandleOut);
+                break;
+            case FFMODFileRequest::TYPE_CLOSE:
+                Request->Result = CloseInternal(Request->HandleIn);
+                break;
+            case FFMODFileRequest::TYPE_READ_AHEAD:
+            {
+                FFMODFileHandle *FileHandle = (FFMODFileHandle *)Request->HandleIn;
+                if (!mCache.Contains(FileHandle->CacheFileId, Request->BlockIndex))
+                {
+                    ReadBlock(FileHandle, Request->BlockIndex, 0, 0, nullptr, AIOP_Low);
+                }
+                break;
+            }
+            case FFMODFileRequest::TYPE_READ:
+            {
+                FMOD_ASYNCREADINFO *info = Request->ReadInfo;
+                Request->Result = ReadInternal(info->handle, info->buffer, info->offset, info->sizebytes, &info->bytesread, GetIOPriority(info->priority));
+                mStats.RecordRequest(((FFMODFileHandle *)info->handle)->Name, info->bytesread, Request->StartTime - Request->EnqueueTime,
+                    FPlatformTime::Seconds() - Request->EnqueueTime);
 
-    // Parameters for Open
-    const char *mName;
-    unsigned int *mFileSize;
-    void **mHandleOut;
+                // Notify FMOD while the request is still in flight, so a concurrent cancel waits for this to happen
+                info->done(info, Request->Result);
+                break;
+            }
+        }
 
-    // Parameters for Read
-    void *mBuffer;
-    unsigned int mSizeBytes;
-    unsigned int *mBytesRead;
+        FEvent *DoneEvent = nullptr;
+        {
+            FScopeLock lock(&mQueueCrit);
+            mInFlight.RemoveSingleSwap(Request, false);
+            DoneEvent = Request->DoneEvent;
+        }
 
-    // Parameter for Seek
-    unsigned int mSeekPosition;
+        if (DoneEvent)
+        {
+            DoneEvent->Trigger();
+        }
+
+        if (Request->CompleteEvent)
+        {
+            // Synchronous requests are owned by the waiting thread
+            Request->CompleteEvent->Trigger();
+        }
+        else
+        {
+            delete Request;
+        }
+    }
+
+    void IssueReadAhead(FFMODFileHandle *FileHandle, int64 BlockIndex)
+    {
+        FFMODFileRequest *Request = new FFMODFileRequest(FFMODFileRequest::TYPE_READ_AHEAD, PRIORITY_READ_AHEAD);
+        Request->HandleIn = FileHandle;
+        Request->BlockIndex = BlockIndex;
+        Enqueue(Request);
+    }
 
-    Command mCommand;
-    FMOD_RESULT mResult;
+    /** Drops queued read ahead for a handle that is about to close, and waits for any that has already started. */
+    void CancelReadAhead(const FFMODFileHandle *FileHandle)
+    {
+        auto IsReadAhead = [FileHandle](const FFMODFileRequest &Request) {
+            return Request.RequestType == FFMODFileRequest::TYPE_READ_AHEAD && Request.HandleIn == FileHandle;
+        };
+
+        {
+            FScopeLock lock(&mQueueCrit);
+
+            for (int32 i = mPending.Num() - 1; i >= 0; --i)
+            {
+                if (IsReadAhead(*mPending[i]))
+                {
+                    delete mPending[i];
+                    mPending.RemoveAtSwap(i, 1, false);
+                }
+            }
+        }
+
+        while (WaitForInFlight(IsReadAhead))
+        {
+        }
+    }
+
+    /**
+     * Blocks until an in-flight request matching the predicate has finished, returning false if there is none. Only one
+     * thread waits on a request: FMOD cancels a read once, and a handle's read ahead is only cancelled when it closes.
+     */
+    template <typename PredicateType> bool WaitForInFlight(PredicateType Predicate)
+    {
+        FEvent *DoneEvent = nullptr;
+        {
+            FScopeLock lock(&mQueueCrit);
+
+            for (FFMODFileRequest *Request : mInFlight)
+            {
+                if (Predicate(*Request))
+                {
+                    check(Request->DoneEvent == nullptr);
+                    DoneEvent = FGenericPlatformProcess::GetSynchEventFromPool();
+                    Request->DoneEvent = DoneEvent;
+                    break;
+                }
+            }
+        }
+
+        if (!DoneEvent)
+        {
+            return false;
+        }
+
+        DoneEvent->Wait();
+        FGenericPlatformProcess::ReturnSynchEventToPool(DoneEvent);
+        return true;
+    }
 
     int mReferenceCount;
-    FRunnableThread *mThread;
-    FEvent *mCommandReadyEvent;
-    FEvent *mCommandCompleteEvent;
+    bool mMemoryMapFiles;
+    bool mUseAsyncReadHandles;
+    int32 mReadAheadBlocks;
+    FFMODFileCache mCache;
+    FFMODFileStats mStats;
+    FFMODFileTraceWriter mTrace;
+    FThreadSafeCounter mOpenHandles;
+    TArray<FWorker *> mWorkers;
+    FCriticalSection mLifetimeCrit;
+
+    /** Workers waiting for a request, protected by mQueueCrit. */
+    TArray<FWorker *> mIdleWorkers;
 
-    FCriticalSection mCrit;
+    TArray<FFMODFileRequest *> mPending;
+    TArray<FFMODFileRequest *> mInFlight;
+    uint64 mNextSequence;
+    bool mStopping;
+    FCriticalSection mQueueCrit;
 };
 
 static FFMODFileSystem gFileSystem;
 
 FMOD_RESULT F_CALLBACK FFMODFileSystem::OpenCallback(const char *name, unsigned int *filesize, void **handle, void * /*userdata*/)
 {
-    FScopeLock lock(&gFileSystem.mCrit);
-    gFileSystem.mName = name;
-    gFileSystem.mFileSize = filesize;
-    gFileSystem.mHandleOut = handle;
+    FFMODFileRequest Request(FFMODFileRequest::TYPE_OPEN, PRIORITY_MAX);
+    Request.Name = name;
+    Request.FileSize = filesize;
+    Request.HandleOut = handle;
 
-    return gFileSystem.RunCommand(COMMAND_OPEN);
+    return gFileSystem.RunSynchronous(Request);
 }
 
 FMOD_RESULT FFMODFileSystem::OpenInternal(const char *name, unsigned int *filesize, void **handle)
 {
     if (name)
     {
-        FArchive *Archive = IFileManager::Get().CreateFileReader(UTF8_TO_TCHAR(name));
-        UE_LOG(LogFMOD, Verbose, TEXT("FFMODFileSystem::OpenInternal opening '%s' returned archive %p"), UTF8_TO_TCHAR(name), Archive);
-        if (!Archive)
+        FString Name = UTF8_TO_TCHAR(name);
+
+        if (gFileSystem.mMemoryMapFiles)
+        {
+            IMappedFileHandle *MappedFile = FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Name);
+            IMappedFileRegion *MappedRegion = MappedFile ? MappedFile->MapRegion() : nullptr;
+            UE_LOG(LogFMOD, Verbose, TEXT("FFMODFileSystem::OpenInternal mapping '%s' returned region %p"), *Name, MappedRegion);
+            if (MappedRegion)
+            {
+                *filesize = MappedRegion->GetMappedSize();
+                FFMODFileHandle *FileHandle = new FFMODFileHandle(Name, MappedRegion->GetMappedSize());
+                FileHandle->MappedFile = MappedFile;
+                FileHandle->MappedRegion = MappedRegion;
+                *handle = FileHandle;
+                gFileSystem.OnOpened(FileHandle);
+                UE_LOG(LogFMOD, Verbose, TEXT("  TotalSize = %d"), *filesize);
+                return FMOD_OK;
+            }
+            delete MappedFile;
+        }
+
+        FFMODFileHandle *FileHandle = nullptr;
+        if (gFileSystem.mUseAsyncReadHandles)
+        {
+            IAsyncReadFileHandle *AsyncHandle = FPlatformFileManager::Get().GetPlatformFile().OpenAsyncRead(*Name);
+            IAsyncReadRequest *SizeRequest = AsyncHandle ? AsyncHandle->SizeRequest() : nullptr;
+            int64 Size = -1;
+            if (SizeRequest)
+            {
+                SizeRequest->WaitCompletion();
+                Size = SizeRequest->GetSizeResults();
+                delete SizeRequest;
+            }
+            UE_LOG(LogFMOD, Verbose, TEXT("FFMODFileSystem::OpenInternal opening '%s' returned async handle %p"), *Name, AsyncHandle);
+            if (Size < 0)
+            {
+                delete AsyncHandle;
+                return FMOD_ERR_FILE_NOTFOUND;
+            }
+            FileHandle = new FFMODFileHandle(Name, Size);
+            FileHandle->AsyncHandle = AsyncHandle;
+        }
+        else
+        {
+            FArchive *Archive = IFileManager::Get().CreateFileReader(*Name);
+            UE_LOG(LogFMOD, Verbose, TEXT("FFMODFileSystem::OpenInternal opening '%s' returned archive %p"), *Name, Archive);
+            if (!Archive)
+            {
+                return FMOD_ERR_FILE_NOTFOUND;
+            }
+            FileHandle = new FFMODFileHandle(Name, Archive->TotalSize());
+            FileHandle->Archive = Archive;
+        }
+
+        *filesize = FileHandle->FileSize;
+        if (gFileSystem.mCache.IsEnabled())
         {
-            return FMOD_ERR_FILE_NOTFOUND;
+            FileHandle->CacheFileId = gFileSystem.mCache.AcquireFile(Name, *filesize, IFileManager::Get().GetTimeStamp(*Name));
         }
-        *filesize = Archive->TotalSize();
-        *handle = Archive;
+        *handle = FileHandle;
+        gFileSystem.OnOpened(FileHandle);
         UE_LOG(LogFMOD, Verbose, TEXT("  TotalSize = %d"), *filesize);
     }
 
@@ -251,10 +708,10 @@ FMOD_RESULT FFMODFileSystem::OpenInternal(const char *name, unsigned int *filesi
 
 FMOD_RESULT F_CALLBACK FFMODFileSystem::CloseCallback(void *handle, void * /*userdata*/)
 {
-    FScopeLock lock(&gFileSystem.mCrit);
-    gFileSystem.mHandleIn = handle;
+    FFMODFileRequest Request(FFMODFileRequest::TYPE_CLOSE, PRIORITY_MAX);
+    Request.HandleIn = handle;
 
-    return gFileSystem.RunCommand(COMMAND_CLOSE);
+    return gFileSystem.RunSynchronous(Request);
 }
 
 FMOD_RESULT FFMODFileSystem::CloseInternal(void *handle)
@@ -264,39 +721,112 @@ FMOD_RESULT FFMODFileSystem::CloseInternal(void *handle)
         return FMOD_ERR_INVALID_PARAM;
     }
 
-    FArchive *Archive = (FArchive *)handle;
-    UE_LOG(LogFMOD, Verbose, TEXT("FFMODFileSystem::CloseCallback closing archive %p"), Archive);
-    delete Archive;
+    FFMODFileHandle *FileHandle = (FFMODFileHandle *)handle;
+    gFileSystem.mOpenHandles.Decrement();
+    gFileSystem.mStats.RecordClose(FileHandle->Name);
+    gFileSystem.mTrace.RecordClose(FileHandle->TraceId);
+    if (FileHandle->MappedRegion)
+    {
+        UE_LOG(LogFMOD, Verbose, TEXT("FFMODFileSystem::CloseCallback unmapping region %p"), FileHandle->MappedRegion);
+        // Regions must be released before the file they were mapped from
+        delete FileHandle->MappedRegion;
+        delete FileHandle->MappedFile;
+    }
+    else
+    {
+        UE_LOG(LogFMOD, Verbose, TEXT("FFMODFileSystem::CloseCallback closing archive %p, async handle %p"), FileHandle->Archive, FileHandle->AsyncHandle);
+        if (FileHandle->CacheFileId)
+        {
+            gFileSystem.CancelReadAhead(FileHandle);
+            gFileSystem.mCache.ReleaseFile(FileHandle->CacheFileId);
+        }
+        delete FileHandle->Archive;
+        delete FileHandle->AsyncHandle;
+        for (uint8 *Buffer : FileHandle->BlockBuffers)
+        {
+            FMemory::Free(Buffer);
+        }
+    }
+    delete FileHandle;
 
     return FMOD_OK;
 }
 
-FMOD_RESULT F_CALLBACK FFMODFileSystem::ReadCallback(void *handle, void *buffer, unsigned int sizebytes, unsigned int *bytesread, void * /*userdata*/)
+FMOD_RESULT F_CALLBACK FFMODFileSystem::AsyncReadCallback(FMOD_ASYNCREADINFO *info, void * /*userdata*/)
 {
-    FScopeLock lock(&gFileSystem.mCrit);
-    gFileSystem.mHandleIn = handle;
-    gFileSystem.mBuffer = buffer;
-    gFileSystem.mSizeBytes = sizebytes;
-    gFileSystem.mBytesRead = bytesread;
+    FFMODFileHandle *FileHandle = (FFMODFileHandle *)info->handle;
+    if (FileHandle)
+    {
+        gFileSystem.mTrace.RecordRead(FileHandle->TraceId, info->offset, info->sizebytes, info->priority);
+    }
+
+    FFMODFileRequest *Request = new FFMODFileRequest(FFMODFileRequest::TYPE_READ, info->priority);
+    Request->ReadInfo = info;
+    gFileSystem.Enqueue(Request);
 
-    return gFileSystem.RunCommand(COMMAND_READ);
+    return FMOD_OK;
 }
 
-FMOD_RESULT FFMODFileSystem::ReadInternal(void *handle, void *buffer, unsigned int sizebytes, unsigned int *bytesread)
+FMOD_RESULT FFMODFileSystem::ReadInternal(void *handle, void *buffer, unsigned int offset, unsigned int sizebytes, unsigned int *bytesread, EAsyncIOPriorityAndFlags ioPriority)
 {
     if (!handle)
     {
         return FMOD_ERR_INVALID_PARAM;
     }
 
+    FFMODFileHandle *FileHandle = (FFMODFileHandle *)handle;
+    if (FileHandle->MappedRegion)
+    {
+        return ReadMapped(FileHandle, buffer, offset, sizebytes, bytesread);
+    }
+    if (FileHandle->CacheFileId)
+    {
+        return ReadCached(FileHandle, buffer, offset, sizebytes, bytesread, ioPriority);
+    }
+
     if (bytesread)
     {
-        FArchive *Archive = (FArchive *)handle;
+        int64 BytesLeft = FMath::Max(FileHandle->FileSize - (int64)offset, (int64)0);
+        int64 ReadAmount = FMath::Min((int64)sizebytes, BytesLeft);
+
+        if (!ReadFromFile(FileHandle, offset, ReadAmount, buffer, ioPriority))
+        {
+            *bytesread = 0;
+            return FMOD_ERR_FILE_BAD;
+        }
+        *bytesread = (unsigned int)ReadAmount;
+        if (ReadAmount < (int64)sizebytes)
+        {
+            UE_LOG(LogFMOD, Verbose, TEXT(" -> EOF "));
+            return FMOD_ERR_FILE_EOF;
+        }
+    }
+
+    return FMOD_OK;
+}
 
-        int64 BytesLeft = Archive->TotalSize() - Archive->Tell();
+FMOD_RESULT FFMODFileSystem::ReadMapped(FFMODFileHandle *handle, void *buffer, unsigned int offset, unsigned int sizebytes, unsigned int *bytesread)
+{
+    if (bytesread)
+    {
+        int64 MappedSize = handle->MappedRegion->GetMappedSize();
+        int64 BytesLeft = FMath::Max(MappedSize - (int64)offset, (int64)0);
         int64 ReadAmount = FMath::Min((int64)sizebytes, BytesLeft);
 
-        Archive->Serialize(buffer, ReadAmount);
+        if (ReadAmount > 0)
+        {
+            bool bSeek = false;
+            {
+                FScopeLock lock(&handle->Lock);
+                bSeek = (offset != handle->FilePosition);
+                handle->FilePosition = offset + ReadAmount;
+            }
+
+            // Page faults on the mapping are the file reads, so they are timed and counted the same way
+            double StartTime = FPlatformTime::Seconds();
+            FMemory::Memcpy(buffer, handle->MappedRegion->GetMappedPtr() + offset, ReadAmount);
+            gFileSystem.mStats.RecordFileRead(handle->Name, ReadAmount, bSeek, FPlatformTime::Seconds() - StartTime);
+        }
         *bytesread = (unsigned int)ReadAmount;
         if (ReadAmount < (int64)sizebytes)
         {
@@ -308,31 +838,367 @@ FMOD_RESULT FFMODFileSystem::ReadInternal(void *handle, void *buffer, unsigned i
     return FMOD_OK;
 }
 
-FMOD_RESULT F_CALLBACK FFMODFileSystem::SeekCallback(void *handle, unsigned int pos, void * /*userdata*/)
+FMOD_RESULT FFMODFileSystem::ReadCached(FFMODFileHandle *handle, void *buffer, unsigned int offset, unsigned int sizebytes, unsigned int *bytesread, EAsyncIOPriorityAndFlags ioPriority)
 {
-    FScopeLock lock(&gFileSystem.mCrit);
-    gFileSystem.mHandleIn = handle;
-    gFileSystem.mSeekPosition = pos;
+    if (bytesread)
+    {
+        FFMODFileCache &Cache = gFileSystem.mCache;
+        const int32 BlockSize = Cache.GetBlockSize();
 
-    return gFileSystem.RunCommand(COMMAND_SEEK);
+        int64 BytesLeft = FMath::Max(handle->FileSize - (int64)offset, (int64)0);
+        int64 ReadAmount = FMath::Min((int64)sizebytes, BytesLeft);
+        int64 ReadEnd = (int64)offset + ReadAmount;
+
+        uint8 *Dest = (uint8 *)buffer;
+        for (int64 Position = offset; Position < ReadEnd;)
+        {
+            int64 BlockIndex = Position / BlockSize;
+            int32 OffsetInBlock = (int32)(Position - BlockIndex * BlockSize);
+            int32 Size = (int32)FMath::Min((int64)(BlockSize - OffsetInBlock), ReadEnd - Position);
+
+            if (!Cache.Read(handle->CacheFileId, BlockIndex, OffsetInBlock, Size, Dest) && !ReadBlock(handle, BlockIndex, OffsetInBlock, Size, Dest, ioPriority))
+            {
+                *bytesread = (unsigned int)(Position - offset);
+                return FMOD_ERR_FILE_BAD;
+            }
+
+            Position += Size;
+            Dest += Size;
+        }
+
+        // Read ahead of sequential readers, without issuing the same block twice
+        FScopeLock lock(&handle->Lock);
+        if (ReadAmount > 0 && (int64)offset == handle->NextSequentialOffset && gFileSystem.mReadAheadBlocks > 0)
+        {
+            int64 LastBlock = (handle->FileSize - 1) / BlockSize;
+            int64 FirstAhead = FMath::Max((ReadEnd - 1) / BlockSize + 1, handle->ReadAheadEndBlock);
+            int64 EndAhead = FMath::Min((ReadEnd - 1) / BlockSize + 1 + gFileSystem.mReadAheadBlocks, LastBlock + 1);
+
+            for (int64 BlockIndex = FirstAhead; BlockIndex < EndAhead; ++BlockIndex)
+            {
+                if (!Cache.Contains(handle->CacheFileId, BlockIndex))
+                {
+                    gFileSystem.IssueReadAhead(handle, BlockIndex);
+                }
+            }
+            handle->ReadAheadEndBlock = FMath::Max(handle->ReadAheadEndBlock, EndAhead);
+        }
+        else
+        {
+            handle->ReadAheadEndBlock = 0;
+        }
+        handle->NextSequentialOffset = ReadEnd;
+
+        *bytesread = (unsigned int)ReadAmount;
+        if (ReadAmount < (int64)sizebytes)
+        {
+            UE_LOG(LogFMOD, Verbose, TEXT(" -> EOF "));
+            return FMOD_ERR_FILE_EOF;
+        }
+    }
+
+    return FMOD_OK;
 }
 
-FMOD_RESULT FFMODFileSystem::SeekInternal(void *handle, unsigned int pos)
+bool FFMODFileSystem::ReadBlock(FFMODFileHandle *handle, int64 blockIndex, int32 offsetInBlock, int32 size, void *dest, EAsyncIOPriorityAndFlags ioPriority)
 {
-    if (!handle)
+    FFMODFileCache &Cache = gFileSystem.mCache;
+    const int32 BlockSize = Cache.GetBlockSize();
+
+    int64 BlockStart = blockIndex * BlockSize;
+    int32 BlockBytes = (int32)FMath::Min((int64)BlockSize, handle->FileSize - BlockStart);
+    if (BlockBytes <= 0)
     {
-        return FMOD_ERR_INVALID_PARAM;
+        return false;
+    }
+
+    uint8 *Buffer = handle->AcquireBlockBuffer(BlockSize);
+    bool bSucceeded = ReadFromFile(handle, BlockStart, BlockBytes, Buffer, ioPriority);
+    if (bSucceeded)
+    {
+        Cache.Insert(handle->CacheFileId, blockIndex, Buffer, BlockBytes);
+
+        if (dest)
+        {
+            FMemory::Memcpy(dest, Buffer + offsetInBlock, size);
+        }
+    }
+    else
+    {
+        UE_LOG(LogFMOD, Warning, TEXT("FFMODFileSystem failed to read block %lld of '%s'"), blockIndex, *handle->Name);
+    }
+    handle->ReleaseBlockBuffer(Buffer);
+    return bSucceeded;
+}
+
+bool FFMODFileSystem::ReadFromFile(FFMODFileHandle *handle, int64 offset, int64 size, void *dest, EAsyncIOPriorityAndFlags ioPriority)
+{
+    if (size <= 0)
+    {
+        return true;
+    }
+
+    bool bSeek = false;
+    {
+        FScopeLock lock(&handle->Lock);
+        bSeek = (offset != handle->FilePosition);
+        handle->FilePosition = offset + size;
+    }
+
+    double StartTime = FPlatformTime::Seconds();
+    bool bSucceeded = false;
+
+    if (handle->AsyncHandle)
+    {
+        // Each worker waits on its own request, the engine schedules the requests of all workers by priority. The
+        // completion callback is the only place the engine reports whether the request was cancelled.
+        bool bCancelled = true;
+        FAsyncFileCallBack Callback = [&bCancelled](bool bWasCancelled, IAsyncReadRequest *) { bCancelled = bWasCancelled; };
+        IAsyncReadRequest *Request = handle->AsyncHandle->ReadRequest(offset, size, ioPriority, &Callback, (uint8 *)dest);
+        if (Request)
+        {
+            bool bCompleted = Request->WaitCompletion();
+            if (!bCompleted)
+            {
+                // The request must finish before it can be deleted
+                Request->Cancel();
+                Request->WaitCompletion();
+            }
+            bSucceeded = bCompleted && !bCancelled;
+            delete Request;
+        }
+    }
+    else
+    {
+        FScopeLock lock(&handle->Lock);
+        FArchive *Archive = handle->Archive;
+        Archive->Seek(offset);
+        Archive->Serialize(dest, size);
+        bSucceeded = !Archive->IsError();
+    }
+
+    gFileSystem.mStats.RecordFileRead(handle->Name, size, bSeek, FPlatformTime::Seconds() - StartTime);
+    return bSucceeded;
+}
+
+FMOD_RESULT F_CALLBACK FFMODFileSystem::AsyncCancelCallback(FMOD_ASYNCREADINFO *info, void * /*userdata*/)
+{
+    FFMODFileRequest *Cancelled = nullptr;
+    {
+        FScopeLock lock(&gFileSystem.mQueueCrit);
+
+        for (int32 i = 0; i < gFileSystem.mPending.Num(); ++i)
+        {
+            if (gFileSystem.mPending[i]->ReadInfo == info)
+            {
+                Cancelled = gFileSystem.mPending[i];
+                gFileSystem.mPending.RemoveAtSwap(i, 1, false);
+                break;
+            }
+        }
     }
 
-    FArchive *Archive = (FArchive *)handle;
-    Archive->Seek(pos);
+    if (Cancelled)
+    {
+        delete Cancelled;
+        info->done(info, FMOD_ERR_FILE_DISKEJECTED);
+        return FMOD_ERR_FILE_DISKEJECTED;
+    }
+
+    // The read has already been picked up by a worker, FMOD requires us to wait for it to complete
+    gFileSystem.WaitForInFlight([info](const FFMODFileRequest &Request) { return Request.ReadInfo == info; });
 
     return FMOD_OK;
 }
 
-void AcquireFMODFileSystem()
+struct FFMODReplayRead
+{
+    FMOD_ASYNCREADINFO Info;
+    TArray<uint8> Buffer;
+    FThreadSafeBool bDone;
+
+    static void F_CALL Done(FMOD_ASYNCREADINFO *info, FMOD_RESULT /*result*/)
+    {
+        ((FFMODReplayRead *)info->userdata)->bDone = true;
+    }
+};
+
+struct FFMODReplayHandle
+{
+    FFMODReplayHandle()
+        : Handle(nullptr)
+        , CoveredStart(0)
+        , CoveredEnd(0)
+    {
+    }
+
+    void *Handle;
+    TArray<TUniquePtr<FFMODReplayRead>> Reads;
+
+    // Range last read when reissuing stream reads with a different buffer size
+    int64 CoveredStart;
+    int64 CoveredEnd;
+
+    void WaitForReads(bool bAll)
+    {
+        for (int32 i = Reads.Num() - 1; i >= 0; --i)
+        {
+            while (bAll && !Reads[i]->bDone)
+            {
+                FPlatformProcess::Sleep(0.001f);
+            }
+            if (Reads[i]->bDone)
+            {
+                Reads.RemoveAtSwap(i, 1, false);
+            }
+        }
+    }
+};
+
+bool FFMODFileSystem::Replay(const FFMODFileTrace &Trace, const UFMODSettings &Settings, bool bRealTime, FOutputDevice &Ar)
 {
-    gFileSystem.IncrementReferenceCount();
+    {
+        FScopeLock lock(&mLifetimeCrit);
+
+        if (mReferenceCount == 0 || mOpenHandles.GetValue() > 0)
+        {
+            Ar.Logf(ELogVerbosity::Error, TEXT("The FMOD file system must be running with no open files to replay a trace"));
+            return false;
+        }
+
+        StopWorkers();
+        StartWorkers(Settings);
+    }
+    mStats.Reset();
+
+    // Streams read in FileBufferSize chunks, so reads of the recorded buffer size are reissued with the replayed size
+    const int64 BufferSize = Settings.FileBufferSize;
+    const bool bRechunk = Trace.FileBufferSize > 0 && BufferSize > 0 && BufferSize != Trace.FileBufferSize;
+
+    TMap<uint32, FFMODReplayHandle> Handles;
+
+    auto IssueRead = [](FFMODReplayHandle &ReplayHandle, int64 Offset, int64 Size, int32 Priority) {
+        FFMODReplayRead *Read = new FFMODReplayRead;
+        Read->Buffer.SetNumUninitialized(Size);
+        FMemory::Memzero(Read->Info);
+        Read->Info.handle = ReplayHandle.Handle;
+        Read->Info.offset = (unsigned int)Offset;
+        Read->Info.sizebytes = (unsigned int)Size;
+        Read->Info.priority = Priority;
+        Read->Info.userdata = Read;
+        Read->Info.buffer = Read->Buffer.GetData();
+        Read->Info.done = &FFMODReplayRead::Done;
+        ReplayHandle.Reads.Emplace(Read);
+        AsyncReadCallback(&Read->Info, nullptr);
+    };
+
+    double StartTime = FPlatformTime::Seconds();
+
+    for (const FFMODFileTraceEvent &Event : Trace.Events)
+    {
+        if (bRealTime)
+        {
+            double Delay = StartTime + Event.Time - FPlatformTime::Seconds();
+            if (Delay > 0)
+            {
+                FPlatformProcess::Sleep(Delay);
+            }
+        }
+
+        if (Event.EventType == FFMODFileTraceEvent::TYPE_OPEN)
+        {
+            FFMODReplayHandle ReplayHandle;
+            unsigned int FileSize = 0;
+            if (OpenCallback(TCHAR_TO_UTF8(*Event.Name), &FileSize, &ReplayHandle.Handle, nullptr) != FMOD_OK)
+            {
+                Ar.Logf(ELogVerbosity::Warning, TEXT("Failed to open '%s', skipping its reads"), *Event.Name);
+                continue;
+            }
+            Handles.Add(Event.HandleId, MoveTemp(ReplayHandle));
+            continue;
+        }
+
+        FFMODReplayHandle *ReplayHandle = Handles.Find(Event.HandleId);
+        if (!ReplayHandle)
+        {
+            continue;
+        }
+
+        if (Event.EventType == FFMODFileTraceEvent::TYPE_CLOSE)
+        {
+            ReplayHandle->WaitForReads(true);
+            CloseCallback(ReplayHandle->Handle, nullptr);
+            Handles.Remove(Event.HandleId);
+        }
+        else if (bRechunk && (int64)Event.Size == Trace.FileBufferSize)
+        {
+            int64 Start = Event.Offset;
+            int64 End = Start + Event.Size;
+            if (Start >= ReplayHandle->CoveredStart && End <= ReplayHandle->CoveredEnd)
+            {
+                continue;
+            }
+
+            if (Start >= ReplayHandle->CoveredStart && Start < ReplayHandle->CoveredEnd)
+            {
+                Start = ReplayHandle->CoveredEnd;
+            }
+            else
+            {
+                ReplayHandle->CoveredStart = Start;
+            }
+
+            for (; Start < End; Start += BufferSize)
+            {
+                IssueRead(*ReplayHandle, Start, BufferSize, Event.Priority);
+            }
+            ReplayHandle->CoveredEnd = Start;
+        }
+        else
+        {
+            IssueRead(*ReplayHandle, Event.Offset, Event.Size, Event.Priority);
+        }
+
+        ReplayHandle->WaitForReads(false);
+    }
+
+    for (TPair<uint32, FFMODReplayHandle> &Pair : Handles)
+    {
+        Pair.Value.WaitForReads(true);
+        CloseCallback(Pair.Value.Handle, nullptr);
+    }
+
+    Ar.Logf(TEXT("Replayed %d events in %.3fs (recorded over %.3fs)"), Trace.Events.Num(), FPlatformTime::Seconds() - StartTime,
+        Trace.Events.Num() ? Trace.Events.Last().Time : 0.0);
+    mStats.Dump(Ar);
+
+    {
+        FScopeLock lock(&mLifetimeCrit);
+        StopWorkers();
+        StartWorkers(*GetDefault<UFMODSettings>());
+    }
+
+    return true;
+}
+
+static void DumpFMODFileStats(const TArray<FString> &Args, UWorld * /*World*/, FOutputDevice &Ar)
+{
+    if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+    {
+        gFileSystem.GetStats().Reset();
+        return;
+    }
+
+    gFileSystem.GetStats().Dump(Ar);
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice FMODFileStatsCommand(TEXT("fmod.FileStats"),
+    TEXT("Dumps per file and total FMOD file I/O statistics. Use 'fmod.FileStats reset' to clear them."),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&DumpFMODFileStats));
+
+void AcquireFMODFileSystem(const UFMODSettings &Settings)
+{
+    gFileSystem.IncrementReferenceCount(Settings);
 }
 
 void ReleaseFMODFileSystem()
@@ -344,3 +1210,15 @@ void AttachFMODFileSystem(FMOD::System *system, int32 fileBufferSize)
 {
     gFileSystem.Attach(system, fileBufferSize);
 }
+
+bool ReplayFMODFileTrace(const FString &TracePath, const UFMODSettings &Settings, bool bRealTime, FOutputDevice &Ar)
+{
+    FFMODFileTrace Trace;
+    if (!Trace.Load(TracePath))
+    {
+        return false;
+    }
+
+    Ar.Logf(TEXT("Replaying FMOD file trace '%s' (recorded with FileBufferSize %d)"), *TracePath, Trace.FileBufferSize);
+    return gFileSystem.Replay(Trace, Settings, bRealTime, Ar);
+}
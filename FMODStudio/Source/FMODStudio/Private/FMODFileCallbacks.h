@@ -2,12 +2,19 @@
 
 #pragma once
 
+#include "CoreMinimal.h"
 #include "fmod.hpp"
 #include "GenericPlatform/GenericPlatform.h"
 
+class UFMODSettings;
+class FOutputDevice;
+
 FMOD_RESULT F_CALLBACK FMODLogCallback(FMOD_DEBUG_FLAGS flags, const char *file, int line, const char *func, const char *message);
 FMOD_RESULT F_CALLBACK FMODErrorCallback(FMOD_SYSTEM *system, FMOD_SYSTEM_CALLBACK_TYPE type, void *commanddata1, void *commanddata2, void *userdata);
 
-void AcquireFMODFileSystem();
+void AcquireFMODFileSystem(const UFMODSettings &Settings);
 void ReleaseFMODFileSystem();
 void AttachFMODFileSystem(FMOD::System *system, FGenericPlatformTypes::int32 fileBufferSize);
+
+/** Replays a trace recorded with -FMODFileTrace against the given file settings, and reports timings to Ar. */
+FMODSTUDIO_API bool ReplayFMODFileTrace(const FString &TracePath, const UFMODSettings &Settings, bool bRealTime, FOutputDevice &Ar);
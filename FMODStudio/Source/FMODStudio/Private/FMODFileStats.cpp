@@ -0,0 +1,164 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#include "FMODFileStats.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/ScopeLock.h"
+#include "FMODStudioPrivatePCH.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("FMOD File - Open Handles"), STAT_FMOD_File_OpenHandles, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD File - Opens"), STAT_FMOD_File_Opens, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD File - Requests"), STAT_FMOD_File_Requests, STATGROUP_FMOD);
+DECLARE_MEMORY_STAT(TEXT("FMOD File - Bytes Requested"), STAT_FMOD_File_BytesRequested, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD File - Reads"), STAT_FMOD_File_Reads, STATGROUP_FMOD);
+DECLARE_MEMORY_STAT(TEXT("FMOD File - Bytes Read"), STAT_FMOD_File_BytesRead, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD File - Seeks"), STAT_FMOD_File_Seeks, STATGROUP_FMOD);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("FMOD File - Read Time (ms)"), STAT_FMOD_File_ReadTime, STATGROUP_FMOD);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("FMOD File - Queue Wait (ms)"), STAT_FMOD_File_QueueWait, STATGROUP_FMOD);
+
+FFMODFileStats::FCounters::FCounters()
+    : Opens(0)
+    , OpenHandles(0)
+    , Requests(0)
+    , BytesRequested(0)
+    , FileReads(0)
+    , BytesRead(0)
+    , Seeks(0)
+    , FileReadSeconds(0)
+    , QueueWaitSeconds(0)
+    , MaxQueueWaitSeconds(0)
+    , MaxLatencySeconds(0)
+{
+    FMemory::Memzero(LatencyHistogram);
+}
+
+FFMODFileStats::FFMODFileStats()
+{
+}
+
+void FFMODFileStats::RecordOpen(const FString &Name)
+{
+    INC_DWORD_STAT(STAT_FMOD_File_Opens);
+    INC_DWORD_STAT(STAT_FMOD_File_OpenHandles);
+
+    FScopeLock lock(&Crit);
+
+    for (FCounters *Counters : { &Total, &Files.FindOrAdd(Name) })
+    {
+        ++Counters->Opens;
+        ++Counters->OpenHandles;
+    }
+}
+
+void FFMODFileStats::RecordClose(const FString &Name)
+{
+    DEC_DWORD_STAT(STAT_FMOD_File_OpenHandles);
+
+    FScopeLock lock(&Crit);
+
+    for (FCounters *Counters : { &Total, &Files.FindOrAdd(Name) })
+    {
+        Counters->OpenHandles = FMath::Max(Counters->OpenHandles - 1, 0);
+    }
+}
+
+void FFMODFileStats::RecordRequest(const FString &Name, int64 Bytes, double QueueWaitSeconds, double LatencySeconds)
+{
+    INC_DWORD_STAT(STAT_FMOD_File_Requests);
+    INC_MEMORY_STAT_BY(STAT_FMOD_File_BytesRequested, Bytes);
+    INC_FLOAT_STAT_BY(STAT_FMOD_File_QueueWait, (float)(QueueWaitSeconds * 1000.0));
+
+    int32 Bucket = 0;
+    for (double Limit = 0.001; Bucket < LATENCY_BUCKETS - 1 && LatencySeconds > Limit; Limit *= 2.0)
+    {
+        ++Bucket;
+    }
+
+    FScopeLock lock(&Crit);
+
+    for (FCounters *Counters : { &Total, &Files.FindOrAdd(Name) })
+    {
+        ++Counters->Requests;
+        Counters->BytesRequested += Bytes;
+        Counters->QueueWaitSeconds += QueueWaitSeconds;
+        Counters->MaxQueueWaitSeconds = FMath::Max(Counters->MaxQueueWaitSeconds, QueueWaitSeconds);
+        Counters->MaxLatencySeconds = FMath::Max(Counters->MaxLatencySeconds, LatencySeconds);
+        ++Counters->LatencyHistogram[Bucket];
+    }
+}
+
+void FFMODFileStats::RecordFileRead(const FString &Name, int64 Bytes, bool bSeek, double Seconds)
+{
+    INC_DWORD_STAT(STAT_FMOD_File_Reads);
+    INC_MEMORY_STAT_BY(STAT_FMOD_File_BytesRead, Bytes);
+    INC_FLOAT_STAT_BY(STAT_FMOD_File_ReadTime, (float)(Seconds * 1000.0));
+    if (bSeek)
+    {
+        INC_DWORD_STAT(STAT_FMOD_File_Seeks);
+    }
+
+    FScopeLock lock(&Crit);
+
+    for (FCounters *Counters : { &Total, &Files.FindOrAdd(Name) })
+    {
+        ++Counters->FileReads;
+        Counters->BytesRead += Bytes;
+        Counters->Seeks += bSeek ? 1 : 0;
+        Counters->FileReadSeconds += Seconds;
+    }
+}
+
+void FFMODFileStats::Dump(FOutputDevice &Ar) const
+{
+    FScopeLock lock(&Crit);
+
+    Ar.Logf(TEXT("FMOD file statistics (latency buckets are <=1ms, <=2ms, ... <=128ms, >128ms):"));
+    DumpCounters(Ar, TEXT("Total"), Total);
+
+    TArray<FString> Names;
+    Files.GetKeys(Names);
+    Names.Sort([this](const FString &A, const FString &B) { return Files[A].BytesRead > Files[B].BytesRead; });
+    for (const FString &Name : Names)
+    {
+        DumpCounters(Ar, *Name, Files[Name]);
+    }
+}
+
+void FFMODFileStats::DumpCounters(FOutputDevice &Ar, const TCHAR *Name, const FCounters &Counters)
+{
+    FString Histogram;
+    for (int32 i = 0; i < LATENCY_BUCKETS; ++i)
+    {
+        Histogram += FString::Printf(TEXT("%s%d"), i ? TEXT("/") : TEXT(""), Counters.LatencyHistogram[i]);
+    }
+
+    Ar.Logf(TEXT("  %s"), Name);
+    Ar.Logf(TEXT("    opens %d (%d open), requests %d (%lld bytes), reads %d (%lld bytes, %d seeks, %.2fms)"), Counters.Opens,
+        Counters.OpenHandles, Counters.Requests, Counters.BytesRequested, Counters.FileReads, Counters.BytesRead, Counters.Seeks,
+        Counters.FileReadSeconds * 1000.0);
+    Ar.Logf(TEXT("    queue wait %.2fms (max %.2fms), max latency %.2fms, latency histogram %s"), Counters.QueueWaitSeconds * 1000.0,
+        Counters.MaxQueueWaitSeconds * 1000.0, Counters.MaxLatencySeconds * 1000.0, *Histogram);
+}
+
+void FFMODFileStats::Reset()
+{
+    FScopeLock lock(&Crit);
+
+    // Keep track of handles that are still open across a reset
+    int32 OpenHandles = Total.OpenHandles;
+    Total = FCounters();
+    Total.OpenHandles = OpenHandles;
+
+    for (auto It = Files.CreateIterator(); It; ++It)
+    {
+        if (It.Value().OpenHandles > 0)
+        {
+            OpenHandles = It.Value().OpenHandles;
+            It.Value() = FCounters();
+            It.Value().OpenHandles = OpenHandles;
+        }
+        else
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
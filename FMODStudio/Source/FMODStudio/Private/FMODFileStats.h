@@ -0,0 +1,58 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+class FOutputDevice;
+
+/*
+    Counters for file access made on behalf of FMOD, kept per file and in aggregate. The aggregate values are also
+    published to STATGROUP_FMOD, and the whole set can be dumped with the fmod.FileStats console command.
+*/
+class FFMODFileStats
+{
+public:
+    FFMODFileStats();
+
+    void RecordOpen(const FString &Name);
+    void RecordClose(const FString &Name);
+
+    /** A read requested by FMOD has been completed, whether from disk, cache or a mapping. */
+    void RecordRequest(const FString &Name, int64 Bytes, double QueueWaitSeconds, double LatencySeconds);
+
+    /** A read has been issued to the underlying file. */
+    void RecordFileRead(const FString &Name, int64 Bytes, bool bSeek, double Seconds);
+
+    void Dump(FOutputDevice &Ar) const;
+    void Reset();
+
+private:
+    // Request latency histogram buckets, each bucket holds requests up to 2^i milliseconds and the last holds the rest
+    static const int32 LATENCY_BUCKETS = 9;
+
+    struct FCounters
+    {
+        FCounters();
+
+        int32 Opens;
+        int32 OpenHandles;
+        int32 Requests;
+        int64 BytesRequested;
+        int32 FileReads;
+        int64 BytesRead;
+        int32 Seeks;
+        double FileReadSeconds;
+        double QueueWaitSeconds;
+        double MaxQueueWaitSeconds;
+        double MaxLatencySeconds;
+        int32 LatencyHistogram[LATENCY_BUCKETS];
+    };
+
+    static void DumpCounters(FOutputDevice &Ar, const TCHAR *Name, const FCounters &Counters);
+
+    FCounters Total;
+    TMap<FString, FCounters> Files;
+    mutable FCriticalSection Crit;
+};
@@ -0,0 +1,168 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#include "FMODFileTrace.h"
+#include "HAL/FileManager.h"
+#include "Misc/ScopeLock.h"
+#include "FMODStudioPrivatePCH.h"
+
+static const uint32 FMOD_FILE_TRACE_MAGIC = 0x54464D46; // "FMFT"
+static const uint32 FMOD_FILE_TRACE_VERSION = 1;
+
+FFMODFileTraceWriter::FFMODFileTraceWriter()
+    : Archive(nullptr)
+    , NextHandleId(1)
+    , LastEventTime(0)
+{
+}
+
+FFMODFileTraceWriter::~FFMODFileTraceWriter()
+{
+    Stop();
+}
+
+bool FFMODFileTraceWriter::Start(const FString &Path, int32 FileBufferSize)
+{
+    FScopeLock lock(&Crit);
+
+    check(!Archive);
+    Archive = IFileManager::Get().CreateFileWriter(*Path);
+    if (!Archive)
+    {
+        UE_LOG(LogFMOD, Warning, TEXT("Failed to create FMOD file trace '%s'"), *Path);
+        return false;
+    }
+
+    uint32 Magic = FMOD_FILE_TRACE_MAGIC;
+    uint32 Version = FMOD_FILE_TRACE_VERSION;
+    *Archive << Magic << Version << FileBufferSize;
+
+    NextHandleId = 1;
+    LastEventTime = FPlatformTime::Seconds();
+    UE_LOG(LogFMOD, Log, TEXT("Recording FMOD file trace to '%s'"), *Path);
+    return true;
+}
+
+void FFMODFileTraceWriter::Stop()
+{
+    FScopeLock lock(&Crit);
+
+    if (Archive)
+    {
+        Archive->Close();
+        delete Archive;
+        Archive = nullptr;
+    }
+}
+
+uint32 FFMODFileTraceWriter::RecordOpen(const FString &Name, uint32 FileSize)
+{
+    FScopeLock lock(&Crit);
+
+    if (!Archive)
+    {
+        return 0;
+    }
+
+    uint32 HandleId = NextHandleId++;
+    FString WrittenName = Name;
+    WriteEventHeader(FFMODFileTraceEvent::TYPE_OPEN, HandleId);
+    *Archive << WrittenName << FileSize;
+    return HandleId;
+}
+
+void FFMODFileTraceWriter::RecordClose(uint32 HandleId)
+{
+    FScopeLock lock(&Crit);
+
+    if (Archive && HandleId)
+    {
+        WriteEventHeader(FFMODFileTraceEvent::TYPE_CLOSE, HandleId);
+    }
+}
+
+void FFMODFileTraceWriter::RecordRead(uint32 HandleId, uint32 Offset, uint32 Size, int32 Priority)
+{
+    FScopeLock lock(&Crit);
+
+    if (Archive && HandleId)
+    {
+        uint8 WrittenPriority = (uint8)FMath::Clamp(Priority, 0, 255);
+        WriteEventHeader(FFMODFileTraceEvent::TYPE_READ, HandleId);
+        *Archive << Offset << Size << WrittenPriority;
+    }
+}
+
+void FFMODFileTraceWriter::WriteEventHeader(uint8 EventType, uint32 HandleId)
+{
+    double Now = FPlatformTime::Seconds();
+    uint32 DeltaMicroseconds = (uint32)FMath::Min((Now - LastEventTime) * 1000000.0, (double)MAX_uint32);
+    LastEventTime = Now;
+
+    *Archive << EventType;
+    Archive->SerializeIntPacked(HandleId);
+    Archive->SerializeIntPacked(DeltaMicroseconds);
+}
+
+bool FFMODFileTrace::Load(const FString &Path)
+{
+    Events.Reset();
+
+    TUniquePtr<FArchive> Archive(IFileManager::Get().CreateFileReader(*Path));
+    if (!Archive)
+    {
+        UE_LOG(LogFMOD, Error, TEXT("Failed to open FMOD file trace '%s'"), *Path);
+        return false;
+    }
+
+    uint32 Magic = 0;
+    uint32 Version = 0;
+    *Archive << Magic << Version << FileBufferSize;
+    if (Magic != FMOD_FILE_TRACE_MAGIC || Version != FMOD_FILE_TRACE_VERSION)
+    {
+        UE_LOG(LogFMOD, Error, TEXT("'%s' is not a supported FMOD file trace"), *Path);
+        return false;
+    }
+
+    double Time = 0;
+    while (Archive->Tell() < Archive->TotalSize() && !Archive->IsError())
+    {
+        FFMODFileTraceEvent &Event = Events.AddDefaulted_GetRef();
+
+        uint8 EventType = 0;
+        uint32 DeltaMicroseconds = 0;
+        *Archive << EventType;
+        Archive->SerializeIntPacked(Event.HandleId);
+        Archive->SerializeIntPacked(DeltaMicroseconds);
+
+        Time += DeltaMicroseconds / 1000000.0;
+        Event.EventType = (FFMODFileTraceEvent::Type)EventType;
+        Event.Time = Time;
+
+        switch (Event.EventType)
+        {
+            case FFMODFileTraceEvent::TYPE_OPEN:
+                *Archive << Event.Name << Event.Size;
+                break;
+            case FFMODFileTraceEvent::TYPE_CLOSE:
+                break;
+            case FFMODFileTraceEvent::TYPE_READ:
+            {
+                uint8 Priority = 0;
+                *Archive << Event.Offset << Event.Size << Priority;
+                Event.Priority = Priority;
+                break;
+            }
+            default:
+                UE_LOG(LogFMOD, Error, TEXT("Unknown event type %d in FMOD file trace '%s'"), EventType, *Path);
+                return false;
+        }
+    }
+
+    if (Archive->IsError())
+    {
+        UE_LOG(LogFMOD, Error, TEXT("FMOD file trace '%s' is truncated"), *Path);
+        return false;
+    }
+
+    return true;
+}
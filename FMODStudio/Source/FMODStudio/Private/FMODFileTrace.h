@@ -0,0 +1,86 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+class FArchive;
+
+/*
+    Compact binary trace of the file access FMOD makes through FFMODFileSystem. Traces are recorded when the game is
+    run with -FMODFileTrace[=<path>] and can be replayed with the FMODReplayFileTrace commandlet to compare file settings.
+
+    Layout: a header (magic, version, file buffer size) followed by events. Each event starts with its type, the trace
+    id of the file handle and the time in microseconds since the previous event. FMOD reads always carry their offset,
+    so seeks are implied by non-contiguous reads rather than recorded separately.
+*/
+struct FFMODFileTraceEvent
+{
+    enum Type
+    {
+        TYPE_OPEN,
+        TYPE_CLOSE,
+        TYPE_READ,
+    };
+
+    FFMODFileTraceEvent()
+        : EventType(TYPE_OPEN)
+        , HandleId(0)
+        , Time(0)
+        , Offset(0)
+        , Size(0)
+        , Priority(0)
+    {
+    }
+
+    Type EventType;
+    uint32 HandleId;
+
+    /** Seconds since the trace started. */
+    double Time;
+
+    // Open: file name and size. Read: offset, size and FMOD priority.
+    FString Name;
+    uint32 Offset;
+    uint32 Size;
+    int32 Priority;
+};
+
+class FFMODFileTraceWriter
+{
+public:
+    FFMODFileTraceWriter();
+    ~FFMODFileTraceWriter();
+
+    bool Start(const FString &Path, int32 FileBufferSize);
+    void Stop();
+    bool IsRecording() const { return Archive != nullptr; }
+
+    /** Returns the trace id to record further events for this file with. */
+    uint32 RecordOpen(const FString &Name, uint32 FileSize);
+    void RecordClose(uint32 HandleId);
+    void RecordRead(uint32 HandleId, uint32 Offset, uint32 Size, int32 Priority);
+
+private:
+    void WriteEventHeader(uint8 EventType, uint32 HandleId);
+
+    FArchive *Archive;
+    uint32 NextHandleId;
+    double LastEventTime;
+    FCriticalSection Crit;
+};
+
+struct FFMODFileTrace
+{
+    FFMODFileTrace()
+        : FileBufferSize(0)
+    {
+    }
+
+    /** FileBufferSize the trace was recorded with. */
+    int32 FileBufferSize;
+    TArray<FFMODFileTraceEvent> Events;
+
+    bool Load(const FString &Path);
+};
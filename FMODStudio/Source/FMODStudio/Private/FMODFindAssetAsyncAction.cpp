@@ -0,0 +1,37 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#include "FMODFindAssetAsyncAction.h"
+#include "FMODAsset.h"
+#include "FMODStudioModule.h"
+#include "Engine/StreamableManager.h"
+
+UFMODFindAssetAsyncAction::UFMODFindAssetAsyncAction(const FObjectInitializer &ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+}
+
+UFMODFindAssetAsyncAction *UFMODFindAssetAsyncAction::FindAssetByNameAsync(UObject *WorldContextObject, const FString &Name)
+{
+    UFMODFindAssetAsyncAction *Action = NewObject<UFMODFindAssetAsyncAction>();
+    Action->Name = Name;
+    Action->RegisterWithGameInstance(WorldContextObject);
+    return Action;
+}
+
+void UFMODFindAssetAsyncAction::Activate()
+{
+    TWeakObjectPtr<UFMODFindAssetAsyncAction> WeakThis(this);
+    Handle = IFMODStudioModule::Get().FindAssetByNameAsync(Name, FFMODAssetFoundDelegate::CreateLambda([WeakThis](UFMODAsset *Asset) {
+        if (WeakThis.IsValid())
+        {
+            WeakThis->HandleFound(Asset);
+        }
+    }));
+}
+
+void UFMODFindAssetAsyncAction::HandleFound(UFMODAsset *Asset)
+{
+    OnFound.Broadcast(Asset);
+    Handle.Reset();
+    SetReadyToDestroy();
+}
@@ -0,0 +1,238 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#include "FMODLoadProfiler.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "Serialization/JsonWriter.h"
+#include "fmod_studio.hpp"
+#include "FMODStudioPrivatePCH.h"
+
+FFMODLoadProfiler::FScope::FScope(FFMODLoadProfiler &InProfiler, const FString &InName)
+    : Profiler(InProfiler)
+    , Name(InName)
+    , StartTime(FPlatformTime::Seconds())
+    , bTraced(false)
+{
+#if CPUPROFILERTRACE_ENABLED
+    bTraced = UE_TRACE_CHANNELEXPR_IS_ENABLED(CpuChannel);
+    if (bTraced)
+    {
+        FCpuProfilerTrace::OutputBeginDynamicEvent(*Name);
+    }
+#endif
+}
+
+FFMODLoadProfiler::FScope::~FScope()
+{
+#if CPUPROFILERTRACE_ENABLED
+    if (bTraced)
+    {
+        FCpuProfilerTrace::OutputEndEvent();
+    }
+#endif
+
+    // Stages are only used by the summary, tracing has already recorded them
+    if (!Profiler.OutputPath.IsEmpty())
+    {
+        double Now = FPlatformTime::Seconds();
+        Profiler.Stages.Add({ MoveTemp(Name), StartTime - Profiler.BaseTime, Now - StartTime });
+        Profiler.bDirty = true;
+    }
+}
+
+FFMODLoadProfiler::FFMODLoadProfiler()
+    : BaseTime(FPlatformTime::Seconds())
+    , PendingCount(0)
+    , bDirty(false)
+{
+}
+
+bool FFMODLoadProfiler::IsEnabled() const
+{
+#if CPUPROFILERTRACE_ENABLED
+    if (UE_TRACE_CHANNELEXPR_IS_ENABLED(CpuChannel))
+    {
+        return true;
+    }
+#endif
+    return !OutputPath.IsEmpty();
+}
+
+FFMODLoadProfiler::FBankLoad *FFMODLoadProfiler::FindBank(const TCHAR *Context, const FString &Path)
+{
+    int32 *Index = BankIndices.Find(GetBankKey(Context, Path));
+    return Index ? &Banks[*Index] : nullptr;
+}
+
+void FFMODLoadProfiler::BeginBank(const TCHAR *Context, const FString &Path)
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    // A bank can be queued again before its last load has finished, such as when it is reloaded after a rebuild
+    if (FBankLoad *Previous = FindBank(Context, Path))
+    {
+        CancelLoad(*Previous);
+    }
+
+    BankIndices.Add(GetBankKey(Context, Path), Banks.Num());
+    FBankLoad &Load = Banks.AddDefaulted_GetRef();
+    Load.Context = Context;
+    Load.Path = Path;
+    Load.FileSize = OutputPath.IsEmpty() ? -1 : IFileManager::Get().FileSize(*Path);
+    Load.StartTime = FPlatformTime::Seconds() - BaseTime;
+    Load.LoadTime = -1.0;
+    Load.SampleDataStartTime = -1.0;
+    Load.SampleDataTime = -1.0;
+    Load.SampleDataBank = nullptr;
+    Load.bSucceeded = false;
+
+    ++PendingCount;
+    bDirty = true;
+}
+
+void FFMODLoadProfiler::EndBank(const TCHAR *Context, const FString &Path, bool bSucceeded)
+{
+    FBankLoad *Load = FindBank(Context, Path);
+    if (!Load || Load->LoadTime >= 0.0)
+    {
+        return;
+    }
+
+    Load->LoadTime = FPlatformTime::Seconds() - BaseTime - Load->StartTime;
+    Load->bSucceeded = bSucceeded;
+    --PendingCount;
+
+    TRACE_BOOKMARK(TEXT("FMOD bank %s loaded (%.1fms)"), *FPaths::GetBaseFilename(Path), Load->LoadTime * 1000.0);
+}
+
+void FFMODLoadProfiler::BeginSampleData(const TCHAR *Context, const FString &Path, FMOD::Studio::Bank *Bank)
+{
+    FBankLoad *Load = FindBank(Context, Path);
+    if (Load && !Load->SampleDataBank)
+    {
+        Load->SampleDataBank = Bank;
+        Load->SampleDataStartTime = FPlatformTime::Seconds() - BaseTime;
+        ++PendingCount;
+    }
+}
+
+void FFMODLoadProfiler::CancelLoad(FBankLoad &Load)
+{
+    if (Load.LoadTime < 0.0)
+    {
+        Load.LoadTime = FPlatformTime::Seconds() - BaseTime - Load.StartTime;
+        --PendingCount;
+    }
+    if (Load.SampleDataBank)
+    {
+        Load.SampleDataTime = FPlatformTime::Seconds() - BaseTime - Load.SampleDataStartTime;
+        Load.SampleDataBank = nullptr;
+        --PendingCount;
+    }
+}
+
+void FFMODLoadProfiler::CancelPending(const TCHAR *Context)
+{
+    for (FBankLoad &Load : Banks)
+    {
+        if (Load.Context == Context)
+        {
+            CancelLoad(Load);
+        }
+    }
+}
+
+void FFMODLoadProfiler::Update()
+{
+    if (!bDirty)
+    {
+        return;
+    }
+
+    for (FBankLoad &Load : Banks)
+    {
+        if (Load.SampleDataBank && Load.SampleDataTime < 0.0)
+        {
+            FMOD_STUDIO_LOADING_STATE State = FMOD_STUDIO_LOADING_STATE_ERROR;
+            if (Load.SampleDataBank->getSampleLoadingState(&State) == FMOD_OK && State == FMOD_STUDIO_LOADING_STATE_LOADING)
+            {
+                continue;
+            }
+
+            Load.SampleDataTime = FPlatformTime::Seconds() - BaseTime - Load.SampleDataStartTime;
+            Load.SampleDataBank = nullptr;
+            --PendingCount;
+
+            TRACE_BOOKMARK(TEXT("FMOD bank %s sample data loaded (%.1fms)"), *FPaths::GetBaseFilename(Load.Path), Load.SampleDataTime * 1000.0);
+        }
+    }
+
+    if (PendingCount == 0)
+    {
+        if (!OutputPath.IsEmpty())
+        {
+            WriteJson(OutputPath);
+        }
+        else
+        {
+            // Only kept for the bookmarks, which have all been emitted
+            Banks.Reset();
+            BankIndices.Reset();
+        }
+        bDirty = false;
+    }
+}
+
+bool FFMODLoadProfiler::WriteJson(const FString &Path) const
+{
+    FString Json;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+
+    Writer->WriteObjectStart();
+
+    Writer->WriteArrayStart(TEXT("stages"));
+    for (const FStage &Stage : Stages)
+    {
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("name"), Stage.Name);
+        Writer->WriteValue(TEXT("startMs"), Stage.StartTime * 1000.0);
+        Writer->WriteValue(TEXT("durationMs"), Stage.Duration * 1000.0);
+        Writer->WriteObjectEnd();
+    }
+    Writer->WriteArrayEnd();
+
+    Writer->WriteArrayStart(TEXT("banks"));
+    for (const FBankLoad &Load : Banks)
+    {
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("context"), Load.Context);
+        Writer->WriteValue(TEXT("path"), Load.Path);
+        Writer->WriteValue(TEXT("fileSize"), Load.FileSize);
+        Writer->WriteValue(TEXT("succeeded"), Load.bSucceeded);
+        Writer->WriteValue(TEXT("startMs"), Load.StartTime * 1000.0);
+        Writer->WriteValue(TEXT("loadMs"), Load.LoadTime * 1000.0);
+        if (Load.SampleDataStartTime >= 0.0)
+        {
+            Writer->WriteValue(TEXT("sampleDataMs"), Load.SampleDataTime * 1000.0);
+        }
+        Writer->WriteObjectEnd();
+    }
+    Writer->WriteArrayEnd();
+
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    if (!FFileHelper::SaveStringToFile(Json, *Path))
+    {
+        UE_LOG(LogFMOD, Warning, TEXT("Failed to write FMOD load profile '%s'"), *Path);
+        return false;
+    }
+
+    UE_LOG(LogFMOD, Log, TEXT("Wrote FMOD load profile to '%s'"), *Path);
+    return true;
+}
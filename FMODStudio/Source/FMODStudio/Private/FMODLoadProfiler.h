@@ -0,0 +1,95 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace FMOD
+{
+namespace Studio
+{
+class Bank;
+}
+}
+
+/*
+    Times the stages of starting FMOD (loading libraries, creating systems, loading plugins and the asset table) and
+    each bank load, including the time for its sample data to load. Stages are emitted as Unreal Insights CPU events and
+    bank loads as bookmarks. A JSON summary is written once loading settles when the game is run with
+    -FMODLoadProfile[=<path>]. Nothing is recorded unless an output path is set or the CPU trace channel is enabled.
+*/
+class FFMODLoadProfiler
+{
+public:
+    /** Times a stage for as long as it is in scope. */
+    class FScope
+    {
+    public:
+        FScope(FFMODLoadProfiler &InProfiler, const FString &InName);
+        ~FScope();
+
+    private:
+        FFMODLoadProfiler &Profiler;
+        FString Name;
+        double StartTime;
+        bool bTraced;
+    };
+
+    FFMODLoadProfiler();
+
+    /** Path to write the JSON summary to, or empty to not write one. */
+    void SetOutputPath(const FString &InOutputPath) { OutputPath = InOutputPath; }
+
+    void BeginBank(const TCHAR *Context, const FString &Path);
+    void EndBank(const TCHAR *Context, const FString &Path, bool bSucceeded);
+    void BeginSampleData(const TCHAR *Context, const FString &Path, FMOD::Studio::Bank *Bank);
+
+    /** Ends any loads still pending for a context, for when its system is released. */
+    void CancelPending(const TCHAR *Context);
+
+    /** Polls sample data loads, and writes the summary once nothing is left loading. */
+    void Update();
+
+    bool WriteJson(const FString &Path) const;
+
+private:
+    struct FStage
+    {
+        FString Name;
+        double StartTime;
+        double Duration;
+    };
+
+    struct FBankLoad
+    {
+        FString Context;
+        FString Path;
+        int64 FileSize;
+        double StartTime;
+        double LoadTime;
+        double SampleDataStartTime;
+        double SampleDataTime;
+        FMOD::Studio::Bank *SampleDataBank;
+        bool bSucceeded;
+    };
+
+    /** True if bank loads should be recorded, for the summary or for trace bookmarks. */
+    bool IsEnabled() const;
+
+    static FString GetBankKey(const TCHAR *Context, const FString &Path) { return FString(Context) + TEXT(":") + Path; }
+    FBankLoad *FindBank(const TCHAR *Context, const FString &Path);
+
+    /** Ends a load, and the load of its sample data, if they are still pending. */
+    void CancelLoad(FBankLoad &Load);
+
+    TArray<FStage> Stages;
+    TArray<FBankLoad> Banks;
+    /** Index into Banks of the most recent load of each bank, keyed by GetBankKey */
+    TMap<FString, int32> BankIndices;
+    FString OutputPath;
+    double BaseTime;
+    int32 PendingCount;
+    bool bDirty;
+};
+
+#define FMOD_LOAD_PROFILE_SCOPE(Profiler, Name) FFMODLoadProfiler::FScope PREPROCESSOR_JOIN(FMODLoadProfileScope, __LINE__)(Profiler, Name)
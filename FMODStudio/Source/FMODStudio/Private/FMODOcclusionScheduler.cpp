@@ -0,0 +1,181 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#include "FMODOcclusionScheduler.h"
+#include "FMODAudioComponent.h"
+#include "FMODEvent.h"
+#include "FMODListener.h"
+#include "FMODUtils.h"
+#include "fmod_studio.hpp"
+#include "FMODStudioPrivatePCH.h"
+
+namespace
+{
+// Emitters beyond their maximum distance are still traced occasionally, so they are up to date when they become audible
+const float MinAudibility = 0.05f;
+}
+
+FFMODOcclusionScheduler::FFMODOcclusionScheduler()
+    : TracesPerFrame(0)
+{
+    TraceDelegate.BindRaw(this, &FFMODOcclusionScheduler::OnTraceCompleted);
+}
+
+void FFMODOcclusionScheduler::SetBudget(int32 InTracesPerFrame)
+{
+    TracesPerFrame = FMath::Max(InTracesPerFrame, 0);
+}
+
+void FFMODOcclusionScheduler::Request(UFMODAudioComponent *Component)
+{
+    FEntry &Entry = Entries.FindOrAdd(Component->GetUniqueID());
+    if (Entry.Component != Component)
+    {
+        // A new request, or a unique id reused by a new component
+        Entry = FEntry();
+        Entry.Component = Component;
+    }
+
+    if (!Entry.bRequested)
+    {
+        Entry.bRequested = true;
+        Entry.RequestFrame = GFrameCounter;
+    }
+}
+
+void FFMODOcclusionScheduler::Cancel(UFMODAudioComponent *Component)
+{
+    Entries.Remove(Component->GetUniqueID());
+}
+
+void FFMODOcclusionScheduler::Update(const FFMODListener *Listeners, int ListenerCount)
+{
+    struct FCandidate
+    {
+        FEntry *Entry;
+        UFMODAudioComponent *Component;
+        FVector Location;
+        FVector ListenerLocation;
+        float Priority;
+    };
+
+    TArray<FCandidate, TInlineAllocator<64>> Candidates;
+
+    for (auto It = Entries.CreateIterator(); It; ++It)
+    {
+        FEntry &Entry = It.Value();
+        UFMODAudioComponent *Component = Entry.Component.Get();
+        if (!Component || !Component->GetOwner() || !Component->StudioInstance || !Component->bApplyOcclusionParameter ||
+            !Component->OcclusionDetails.bEnableOcclusion)
+        {
+            It.RemoveCurrent();
+            continue;
+        }
+
+        // Results arrived during the last world tick. Partial occlusion keeps tracing until it has cast all of its rays
+        if (Entry.bHasResult)
+        {
+            if (Component->ApplyOcclusion(Entry.bOccluded) && !Entry.bRequested)
+            {
+                Entry.bRequested = true;
+                Entry.RequestFrame = GFrameCounter;
+            }
+            Entry.bHasResult = false;
+        }
+
+        // Virtual instances wait until they are real again
+        if (!Entry.bRequested || Entry.bTracing || ListenerCount == 0 || (Component->bIsVirtual && Component->VirtualUpdateInterval > 0.0f))
+        {
+            continue;
+        }
+
+        FCandidate Candidate;
+        Candidate.Entry = &Entry;
+        Candidate.Component = Component;
+        Candidate.Location = Component->GetOwner()->GetTransform().GetTranslation();
+
+        float NearestDistSq = FLT_MAX;
+        for (int i = 0; i < ListenerCount; ++i)
+        {
+            const FVector ListenerLocation = Listeners[i].Transform.GetLocation();
+            const float DistSq = FVector::DistSquared(Candidate.Location, ListenerLocation);
+            if (DistSq < NearestDistSq)
+            {
+                NearestDistSq = DistSq;
+                Candidate.ListenerLocation = ListenerLocation;
+            }
+        }
+
+        float MaxDistance = 0.0f;
+        if (Component->AttenuationDetails.bOverrideAttenuation)
+        {
+            MaxDistance = Component->AttenuationDetails.MaximumDistance;
+        }
+        else
+        {
+            FMOD::Studio::EventDescription *EventDesc = nullptr;
+            if (Component->StudioInstance->getDescription(&EventDesc) == FMOD_OK)
+            {
+                EventDesc->getMinMaxDistance(nullptr, &MaxDistance);
+                MaxDistance = FMODUtils::DistanceToUEScale(MaxDistance);
+            }
+        }
+
+        float Audibility = 1.0f;
+        if (MaxDistance > 0.0f)
+        {
+            Audibility = FMath::Max(1.0f - FMath::Sqrt(NearestDistSq) / MaxDistance, MinAudibility);
+        }
+
+        // Audible emitters go first, and waiting raises the priority of the rest so none are starved
+        Candidate.Priority = Audibility * (float)(GFrameCounter - Entry.RequestFrame + 1);
+        Candidates.Add(Candidate);
+    }
+
+    int32 TraceCount = Candidates.Num();
+    if (TracesPerFrame > 0 && TraceCount > TracesPerFrame)
+    {
+        Candidates.Sort([](const FCandidate &A, const FCandidate &B) { return A.Priority > B.Priority; });
+        TraceCount = TracesPerFrame;
+    }
+
+    static FName NAME_SoundOcclusion = FName(TEXT("SoundOcclusion"));
+
+    for (int32 i = 0; i < TraceCount; ++i)
+    {
+        const FCandidate &Candidate = Candidates[i];
+        UFMODAudioComponent *Component = Candidate.Component;
+        UWorld *World = Component->GetWorld();
+        if (!World)
+        {
+            continue;
+        }
+
+        FVector Start = Candidate.Location;
+        FVector End = Candidate.ListenerLocation;
+        if (Component->OcclusionDetails.bEnablePartialOcclusion)
+        {
+            const float JitterRadius = Component->OcclusionDetails.OcclusionJitterRadius;
+            Start += FMath::VRand() * (FMath::FRand() * JitterRadius);
+            End += FMath::VRand() * (FMath::FRand() * JitterRadius);
+        }
+
+        FCollisionQueryParams Params(NAME_SoundOcclusion, Component->OcclusionDetails.bUseComplexCollisionForOcclusion, Component->GetOwner());
+        World->AsyncLineTraceByChannel(EAsyncTraceType::Test, Start, End,
+            Component->OcclusionDetails.OcclusionTraceChannel, Params, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate,
+            Component->GetUniqueID());
+
+        Candidate.Entry->bRequested = false;
+        Candidate.Entry->bTracing = true;
+    }
+}
+
+void FFMODOcclusionScheduler::OnTraceCompleted(const FTraceHandle &Handle, FTraceDatum &Datum)
+{
+    FEntry *Entry = Entries.Find(Datum.UserData);
+    if (Entry && Entry->bTracing)
+    {
+        Entry->bTracing = false;
+        Entry->bHasResult = true;
+        Entry->bOccluded = Datum.OutHits.Num() > 0;
+    }
+}
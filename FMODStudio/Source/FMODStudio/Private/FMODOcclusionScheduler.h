@@ -0,0 +1,61 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/World.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UFMODAudioComponent;
+struct FFMODListener;
+
+/*
+    Traces occlusion for audio components asynchronously. Components request an update when they or the listener move,
+    and each frame the most audible of the waiting components are traced, up to the per-frame budget. The traces complete
+    during the next world tick and their results are applied to the components on the following update.
+    Components using partial occlusion cast one jittered ray per trace and are requeued until they have cast all of their
+    rays.
+*/
+class FFMODOcclusionScheduler
+{
+public:
+    FFMODOcclusionScheduler();
+
+    /** Sets the maximum number of traces issued per frame, or 0 for no limit. */
+    void SetBudget(int32 InTracesPerFrame);
+
+    void Request(UFMODAudioComponent *Component);
+    void Cancel(UFMODAudioComponent *Component);
+
+    void Update(const FFMODListener *Listeners, int ListenerCount);
+
+private:
+    struct FEntry
+    {
+        FEntry()
+            : RequestFrame(0)
+            , bRequested(false)
+            , bTracing(false)
+            , bHasResult(false)
+            , bOccluded(false)
+        {
+        }
+
+        TWeakObjectPtr<UFMODAudioComponent> Component;
+
+        /** The frame the oldest unserviced request was made on. */
+        uint64 RequestFrame;
+
+        uint32 bRequested : 1;
+        uint32 bTracing : 1;
+        uint32 bHasResult : 1;
+        uint32 bOccluded : 1;
+    };
+
+    void OnTraceCompleted(const FTraceHandle &Handle, FTraceDatum &Datum);
+
+    /** Requests by component unique id, which is passed through the trace as its user data. */
+    TMap<uint32, FEntry> Entries;
+    FTraceDelegate TraceDelegate;
+    int32 TracesPerFrame;
+};
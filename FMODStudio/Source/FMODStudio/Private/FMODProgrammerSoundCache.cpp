@@ -0,0 +1,430 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#include "FMODProgrammerSoundCache.h"
+#include "fmod_studio.hpp"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "FMODStudioPrivatePCH.h"
+
+DECLARE_MEMORY_STAT(TEXT("FMOD Programmer Sounds - Cached"), STAT_FMOD_ProgrammerSounds_Cached, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Programmer Sounds - Created"), STAT_FMOD_ProgrammerSounds_Created, STATGROUP_FMOD);
+
+static bool IsProgrammerSoundUrl(const FString &Name)
+{
+    return Name.StartsWith(TEXT("http://")) || Name.StartsWith(TEXT("http:\\\\")) || Name.StartsWith(TEXT("https://")) ||
+           Name.StartsWith(TEXT("https:\\\\"));
+}
+
+FFMODProgrammerSoundCache::FFMODProgrammerSoundCache()
+    : Budget(0)
+    , ResidentBytes(0)
+    , UseCounter(0)
+{
+}
+
+void FFMODProgrammerSoundCache::SetBudget(int64 InBudget)
+{
+    FScopeLock Lock(&CriticalSection);
+    Budget = InBudget;
+}
+
+FString FFMODProgrammerSoundCache::GetKey(const FString &Name)
+{
+    // Files are keyed by their full path, so relative and absolute names of the same file share a sound
+    if (!IsProgrammerSoundUrl(Name) && Name.Contains(TEXT(".")) && FPaths::IsRelative(Name))
+    {
+        return FPaths::ProjectContentDir() / Name;
+    }
+    return Name;
+}
+
+bool FFMODProgrammerSoundCache::IsAudioTableKey(const FString &Key)
+{
+    return !IsProgrammerSoundUrl(Key) && !Key.Contains(TEXT("."));
+}
+
+FMOD::Sound *FFMODProgrammerSoundCache::CreateSound(FMOD::Studio::System *System, const FString &Key, int32 &OutSubsoundIndex, bool &bOutStream)
+{
+    FMOD::System *LowLevelSystem = nullptr;
+    System->getCoreSystem(&LowLevelSystem);
+    FMOD_MODE SoundMode = FMOD_LOOP_NORMAL | FMOD_CREATECOMPRESSEDSAMPLE | FMOD_NONBLOCKING;
+    FMOD::Sound *Sound = nullptr;
+    OutSubsoundIndex = -1;
+    bOutStream = false;
+
+    if (IsProgrammerSoundUrl(Key))
+    {
+        // Load via url
+        FMOD_CREATESOUNDEXINFO exinfo;
+        memset(&exinfo, 0, sizeof(FMOD_CREATESOUNDEXINFO));
+        exinfo.cbsize = sizeof(FMOD_CREATESOUNDEXINFO);
+        exinfo.filebuffersize = 1024 * 16;
+        exinfo.ignoresetfilesystem = true;
+
+        if (LowLevelSystem->createSound(TCHAR_TO_UTF8(*Key), FMOD_CREATESTREAM | FMOD_NONBLOCKING, &exinfo, &Sound) == FMOD_OK)
+        {
+            UE_LOG(LogFMOD, Verbose, TEXT("Creating programmer sound from url '%s'"), *Key);
+            bOutStream = true;
+        }
+        else
+        {
+            UE_LOG(LogFMOD, Warning, TEXT("Failed to load programmer sound url '%s'"), *Key);
+        }
+    }
+    else if (Key.Contains(TEXT(".")))
+    {
+        // Load via file
+        if (LowLevelSystem->createSound(TCHAR_TO_UTF8(*Key), SoundMode, nullptr, &Sound) == FMOD_OK)
+        {
+            UE_LOG(LogFMOD, Verbose, TEXT("Creating programmer sound from file '%s'"), *Key);
+        }
+        else
+        {
+            UE_LOG(LogFMOD, Warning, TEXT("Failed to load programmer sound file '%s'"), *Key);
+        }
+    }
+    else
+    {
+        // Load via FMOD Studio asset table
+        FMOD_STUDIO_SOUND_INFO SoundInfo = { 0 };
+        FMOD_RESULT Result = System->getSoundInfo(TCHAR_TO_UTF8(*Key), &SoundInfo);
+        if (Result == FMOD_OK)
+        {
+            Result = LowLevelSystem->createSound(SoundInfo.name_or_data, SoundMode | SoundInfo.mode, &SoundInfo.exinfo, &Sound);
+            if (Result == FMOD_OK)
+            {
+                UE_LOG(LogFMOD, Verbose, TEXT("Creating programmer sound using audio entry '%s'"), *Key);
+                OutSubsoundIndex = SoundInfo.subsoundindex;
+                bOutStream = (SoundInfo.mode & FMOD_CREATESTREAM) != 0;
+            }
+            else
+            {
+                UE_LOG(LogFMOD, Warning, TEXT("Failed to load FMOD audio entry '%s'"), *Key);
+            }
+        }
+        else
+        {
+            UE_LOG(LogFMOD, Warning, TEXT("Failed to find FMOD audio entry '%s'"), *Key);
+        }
+    }
+
+    if (Sound)
+    {
+        INC_DWORD_STAT(STAT_FMOD_ProgrammerSounds_Created);
+    }
+    return Sound;
+}
+
+FMOD::Sound *FFMODProgrammerSoundCache::AddSound(const FString &Key, FMOD::Sound *Sound, int32 SubsoundIndex, FMOD::Sound *&OutDuplicate)
+{
+    // Another thread may have created the same sound while this one was unlocked
+    if (FMOD::Sound **Existing = SoundsByKey.Find(Key))
+    {
+        OutDuplicate = Sound;
+        return *Existing;
+    }
+
+    FEntry &Entry = Entries.Add(Sound);
+    Entry.Key = Key;
+    Entry.SubsoundIndex = SubsoundIndex;
+    SoundsByKey.Add(Key, Sound);
+    OutDuplicate = nullptr;
+    return Sound;
+}
+
+void FFMODProgrammerSoundCache::ReleaseSounds(const TArray<FMOD::Sound *> &Sounds)
+{
+    for (FMOD::Sound *Sound : Sounds)
+    {
+        UE_LOG(LogFMOD, Verbose, TEXT("Destroying programmer sound"));
+        verifyfmod(Sound->release());
+    }
+}
+
+FMOD::Sound *FFMODProgrammerSoundCache::Acquire(FMOD::Studio::System *System, const FString &Name, int32 &OutSubsoundIndex, bool bCache)
+{
+    const FString Key = GetKey(Name);
+
+    if (bCache)
+    {
+        FScopeLock Lock(&CriticalSection);
+        if (FMOD::Sound **Sound = SoundsByKey.Find(Key))
+        {
+            FEntry &Entry = Entries[*Sound];
+            ++Entry.RefCount;
+            Entry.LastUsed = ++UseCounter;
+            OutSubsoundIndex = Entry.SubsoundIndex;
+            return *Sound;
+        }
+    }
+
+    bool bStream = false;
+    FMOD::Sound *Sound = CreateSound(System, Key, OutSubsoundIndex, bStream);
+    if (Sound && bCache && !bStream)
+    {
+        FMOD::Sound *Duplicate = nullptr;
+        {
+            FScopeLock Lock(&CriticalSection);
+            Sound = AddSound(Key, Sound, OutSubsoundIndex, Duplicate);
+
+            FEntry &Entry = Entries[Sound];
+            ++Entry.RefCount;
+            Entry.LastUsed = ++UseCounter;
+            OutSubsoundIndex = Entry.SubsoundIndex;
+        }
+
+        if (Duplicate)
+        {
+            verifyfmod(Duplicate->release());
+        }
+    }
+    return Sound;
+}
+
+void FFMODProgrammerSoundCache::Release(FMOD::Sound *Sound)
+{
+    {
+        FScopeLock Lock(&CriticalSection);
+
+        FEntry *Entry = Entries.Find(Sound);
+        if (Entry)
+        {
+            if (--Entry->RefCount > 0 || ((Budget > 0 || Entry->bPreloaded) && IsCached(Sound, *Entry)))
+            {
+                return;
+            }
+            Evict(Sound);
+        }
+    }
+
+    UE_LOG(LogFMOD, Verbose, TEXT("Destroying programmer sound"));
+    verifyfmod(Sound->release());
+}
+
+void FFMODProgrammerSoundCache::Preload(FMOD::Studio::System *System, const TArray<FString> &Names)
+{
+    for (const FString &Name : Names)
+    {
+        const FString Key = GetKey(Name);
+        {
+            FScopeLock Lock(&CriticalSection);
+            if (FMOD::Sound **Sound = SoundsByKey.Find(Key))
+            {
+                FEntry &Entry = Entries[*Sound];
+                Entry.bPreloaded = true;
+                Entry.LastUsed = ++UseCounter;
+                continue;
+            }
+        }
+
+        int32 SubsoundIndex = -1;
+        bool bStream = false;
+        FMOD::Sound *Sound = CreateSound(System, Key, SubsoundIndex, bStream);
+        if (!Sound)
+        {
+            continue;
+        }
+        if (bStream)
+        {
+            // Streams can't be shared, so they are released as soon as they stop
+            verifyfmod(Sound->release());
+            continue;
+        }
+
+        FMOD::Sound *Duplicate = nullptr;
+        {
+            FScopeLock Lock(&CriticalSection);
+            FEntry &Entry = Entries[AddSound(Key, Sound, SubsoundIndex, Duplicate)];
+            Entry.bPreloaded = true;
+            Entry.LastUsed = ++UseCounter;
+        }
+
+        if (Duplicate)
+        {
+            verifyfmod(Duplicate->release());
+        }
+    }
+}
+
+void FFMODProgrammerSoundCache::Unload(const TArray<FString> &Names)
+{
+    TArray<FMOD::Sound *> Evicted;
+    {
+        FScopeLock Lock(&CriticalSection);
+
+        for (const FString &Name : Names)
+        {
+            FMOD::Sound *Sound = SoundsByKey.FindRef(GetKey(Name));
+            if (FEntry *Entry = Entries.Find(Sound))
+            {
+                Entry->bPreloaded = false;
+                if (Entry->RefCount == 0 && Budget == 0)
+                {
+                    Evict(Sound);
+                    Evicted.Add(Sound);
+                }
+            }
+        }
+    }
+
+    ReleaseSounds(Evicted);
+}
+
+void FFMODProgrammerSoundCache::Update()
+{
+    TArray<FMOD::Sound *> Evicted;
+    {
+        FScopeLock Lock(&CriticalSection);
+        UpdateLocked(Evicted);
+    }
+
+    ReleaseSounds(Evicted);
+}
+
+void FFMODProgrammerSoundCache::UpdateLocked(TArray<FMOD::Sound *> &OutEvicted)
+{
+    if (Entries.Num() == 0)
+    {
+        return;
+    }
+
+    TArray<FMOD::Sound *, TInlineAllocator<8>> Failed;
+    for (auto &Pair : Entries)
+    {
+        FEntry &Entry = Pair.Value;
+        if (Entry.bMeasured)
+        {
+            continue;
+        }
+
+        FMOD_OPENSTATE OpenState = FMOD_OPENSTATE_ERROR;
+        Pair.Key->getOpenState(&OpenState, nullptr, nullptr, nullptr);
+        if (OpenState == FMOD_OPENSTATE_READY)
+        {
+            // Compressed samples stay in memory at their encoded size
+            unsigned int Length = 0;
+            Pair.Key->getLength(&Length, FMOD_TIMEUNIT_RAWBYTES);
+            Entry.Bytes = Length;
+            Entry.bMeasured = true;
+            ResidentBytes += Entry.Bytes;
+        }
+        else if (OpenState == FMOD_OPENSTATE_ERROR && Entry.RefCount == 0)
+        {
+            Failed.Add(Pair.Key);
+        }
+    }
+
+    for (FMOD::Sound *Sound : Failed)
+    {
+        UE_LOG(LogFMOD, Warning, TEXT("Failed to load programmer sound '%s'"), *Entries[Sound].Key);
+        Evict(Sound);
+        OutEvicted.Add(Sound);
+    }
+
+    while (Budget > 0 && ResidentBytes > Budget)
+    {
+        FMOD::Sound *Oldest = nullptr;
+        const FEntry *OldestEntry = nullptr;
+        for (const auto &Pair : Entries)
+        {
+            if (Pair.Value.bMeasured && Pair.Value.RefCount == 0 && !Pair.Value.bPreloaded &&
+                (!OldestEntry || Pair.Value.LastUsed < OldestEntry->LastUsed))
+            {
+                Oldest = Pair.Key;
+                OldestEntry = &Pair.Value;
+            }
+        }
+
+        if (!Oldest)
+        {
+            break;
+        }
+
+        UE_LOG(LogFMOD, Verbose, TEXT("Releasing least recently used programmer sound '%s' (%lld bytes) to stay within budget of %lld bytes"),
+            *OldestEntry->Key, OldestEntry->Bytes, Budget);
+        Evict(Oldest);
+        OutEvicted.Add(Oldest);
+    }
+
+    SET_MEMORY_STAT(STAT_FMOD_ProgrammerSounds_Cached, ResidentBytes);
+}
+
+void FFMODProgrammerSoundCache::Reset()
+{
+    TArray<FMOD::Sound *> Unreferenced;
+    {
+        FScopeLock Lock(&CriticalSection);
+
+        for (auto &Pair : Entries)
+        {
+            if (Pair.Value.RefCount == 0)
+            {
+                Unreferenced.Add(Pair.Key);
+            }
+            Pair.Value.bPreloaded = false;
+        }
+
+        for (FMOD::Sound *Sound : Unreferenced)
+        {
+            Evict(Sound);
+        }
+
+        // Sounds that are still playing belong to the old system, so don't share them with new instances
+        SoundsByKey.Reset();
+        SET_MEMORY_STAT(STAT_FMOD_ProgrammerSounds_Cached, ResidentBytes);
+    }
+
+    ReleaseSounds(Unreferenced);
+}
+
+void FFMODProgrammerSoundCache::ResetAudioTables()
+{
+    TArray<FMOD::Sound *> Unreferenced;
+    {
+        FScopeLock Lock(&CriticalSection);
+
+        for (auto &Pair : Entries)
+        {
+            if (!IsAudioTableKey(Pair.Value.Key))
+            {
+                continue;
+            }
+
+            if (Pair.Value.RefCount == 0)
+            {
+                Unreferenced.Add(Pair.Key);
+            }
+            else if (IsCached(Pair.Key, Pair.Value))
+            {
+                // Still playing the old locale's sound, so don't share it with new instances
+                SoundsByKey.Remove(Pair.Value.Key);
+            }
+            Pair.Value.bPreloaded = false;
+        }
+
+        for (FMOD::Sound *Sound : Unreferenced)
+        {
+            Evict(Sound);
+        }
+
+        SET_MEMORY_STAT(STAT_FMOD_ProgrammerSounds_Cached, ResidentBytes);
+    }
+
+    ReleaseSounds(Unreferenced);
+}
+
+bool FFMODProgrammerSoundCache::IsCached(FMOD::Sound *Sound, const FEntry &Entry) const
+{
+    return SoundsByKey.FindRef(Entry.Key) == Sound;
+}
+
+void FFMODProgrammerSoundCache::Evict(FMOD::Sound *Sound)
+{
+    const FEntry &Entry = Entries[Sound];
+    ResidentBytes -= Entry.Bytes;
+    if (IsCached(Sound, Entry))
+    {
+        SoundsByKey.Remove(Entry.Key);
+    }
+    Entries.Remove(Sound);
+}
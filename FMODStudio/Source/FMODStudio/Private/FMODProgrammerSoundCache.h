@@ -0,0 +1,115 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+namespace FMOD
+{
+class Sound;
+namespace Studio
+{
+class System;
+}
+}
+
+/*
+    Creates the sounds for programmer instruments and shares them between instances playing the same name. A sound is
+    reference counted while it plays, then kept within a memory budget so replaying the same name doesn't create it
+    again, releasing the least recently used sounds first. With a budget of 0 sounds are released once unreferenced.
+
+    Names are audio table keys, file paths relative to the content directory, or urls. Sounds that stream, such as urls,
+    can only be played once at a time, so they are created for every Acquire and never cached.
+
+    Acquire and Release are called from the FMOD Studio update thread, so every method takes the cache's lock. Sounds are
+    created and released outside the lock, since those calls take FMOD's own locks and the Studio thread takes ours while
+    holding them.
+*/
+class FFMODProgrammerSoundCache
+{
+public:
+    FFMODProgrammerSoundCache();
+
+    /** Budget in bytes, or 0 to keep only sounds that are playing or preloaded. */
+    void SetBudget(int64 InBudget);
+
+    /** Returns a sound for a programmer sound name and adds a reference to it, or null if it couldn't be created. */
+    FMOD::Sound *Acquire(FMOD::Studio::System *System, const FString &Name, int32 &OutSubsoundIndex, bool bCache);
+
+    /** Removes a reference to a sound from Acquire, releasing it if it isn't cached. */
+    void Release(FMOD::Sound *Sound);
+
+    /** Starts loading sounds in the background and keeps them until they are unloaded. */
+    void Preload(FMOD::Studio::System *System, const TArray<FString> &Names);
+    void Unload(const TArray<FString> &Names);
+
+    /** Measures newly loaded sounds and releases the least recently used unreferenced sounds while over budget. */
+    void Update();
+
+    /**
+     * Releases every unreferenced sound, for when the system is released. Sounds that are still playing are released by
+     * their last Release.
+     */
+    void Reset();
+
+    /**
+     * Releases unreferenced audio table sounds and stops sharing the ones still playing, for when audio table keys may
+     * resolve to different sounds after a locale change. Sounds loaded from files are kept, along with their preloads.
+     */
+    void ResetAudioTables();
+
+private:
+    struct FEntry
+    {
+        FEntry()
+            : SubsoundIndex(-1)
+            , RefCount(0)
+            , LastUsed(0)
+            , Bytes(0)
+            , bPreloaded(false)
+            , bMeasured(false)
+        {
+        }
+
+        FString Key;
+        int32 SubsoundIndex;
+        int32 RefCount;
+        uint64 LastUsed;
+        int64 Bytes;
+
+        /** True between Preload and Unload, which keeps the sound regardless of the budget. */
+        bool bPreloaded;
+
+        /** False until the sound has finished loading and its size is known. */
+        bool bMeasured;
+    };
+
+    static FString GetKey(const FString &Name);
+    static bool IsAudioTableKey(const FString &Key);
+    static FMOD::Sound *CreateSound(FMOD::Studio::System *System, const FString &Key, int32 &OutSubsoundIndex, bool &bOutStream);
+
+    static void ReleaseSounds(const TArray<FMOD::Sound *> &Sounds);
+
+    /**
+     * Adds an entry for a sound created outside the lock and returns it, or returns the existing sound for the key and
+     * sets OutDuplicate to the new one, which the caller must release once unlocked.
+     */
+    FMOD::Sound *AddSound(const FString &Key, FMOD::Sound *Sound, int32 SubsoundIndex, FMOD::Sound *&OutDuplicate);
+
+    void UpdateLocked(TArray<FMOD::Sound *> &OutEvicted);
+    bool IsCached(FMOD::Sound *Sound, const FEntry &Entry) const;
+
+    /** Removes a sound's entry. The caller releases the sound once unlocked. */
+    void Evict(FMOD::Sound *Sound);
+
+    FCriticalSection CriticalSection;
+    TMap<FMOD::Sound *, FEntry> Entries;
+
+    /** Cached sounds by key. Entries left by a reset that are still playing are no longer found here. */
+    TMap<FString, FMOD::Sound *> SoundsByKey;
+
+    int64 Budget;
+    int64 ResidentBytes;
+    uint64 UseCounter;
+};
@@ -0,0 +1,249 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#include "FMODSampleDataManager.h"
+#include "FMODEventInstancePool.h"
+#include "fmod_studio.hpp"
+#include "FMODStudioPrivatePCH.h"
+
+DECLARE_MEMORY_STAT(TEXT("FMOD Sample Data - Managed"), STAT_FMOD_SampleData_Managed, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Sample Data - Evictions"), STAT_FMOD_SampleData_Evictions, STATGROUP_FMOD);
+
+namespace
+{
+// Sample data allocated by FMOD, when it allocates through the module's memory callbacks
+FThreadSafeCounter64 TrackedSampleDataBytes;
+bool bSampleDataTracked = false;
+}
+
+void FFMODSampleDataManager::EnableAllocationTracking()
+{
+    bSampleDataTracked = true;
+}
+
+void FFMODSampleDataManager::TrackAllocation(int64 Bytes)
+{
+    TrackedSampleDataBytes.Add(Bytes);
+}
+
+FFMODSampleDataManager::FFMODSampleDataManager()
+    : System(nullptr)
+    , Budget(0)
+    , ResidentBytes(0)
+    , BatchStartBytes(-1)
+    , LoadingCount(0)
+    , UseCounter(0)
+{
+}
+
+FFMODSampleDataManager::FEntry &FFMODSampleDataManager::FindOrLoad(FMOD::Studio::EventDescription *EventDesc)
+{
+    FEntry *Entry = Entries.Find(EventDesc);
+    if (!Entry)
+    {
+        // Loads that overlap are measured together, from before the first one starts until the last one finishes
+        if (LoadingCount == 0)
+        {
+            BatchStartBytes = GetSampleDataBytes();
+        }
+        ++LoadingCount;
+
+        verifyfmod(EventDesc->loadSampleData());
+        Entry = &Entries.Add(EventDesc);
+        Entry->bLoading = true;
+    }
+    Entry->LastUsed = ++UseCounter;
+    return *Entry;
+}
+
+void FFMODSampleDataManager::Remove(FMOD::Studio::EventDescription *EventDesc, FEntry &Entry)
+{
+    if (Entry.bLoading)
+    {
+        --LoadingCount;
+    }
+    ResidentBytes -= Entry.Bytes;
+    Entries.Remove(EventDesc);
+}
+
+void FFMODSampleDataManager::Load(FMOD::Studio::EventDescription *EventDesc)
+{
+    if (EventDesc)
+    {
+        ++FindOrLoad(EventDesc).LoadCount;
+    }
+}
+
+void FFMODSampleDataManager::Unload(FMOD::Studio::EventDescription *EventDesc)
+{
+    // Without an entry there is no load of ours to balance, e.g. it has already been evicted
+    FEntry *Entry = Entries.Find(EventDesc);
+    if (!Entry || Entry->LoadCount == 0)
+    {
+        return;
+    }
+
+    if (--Entry->LoadCount == 0 && Entry->PrefetchCount == 0)
+    {
+        Remove(EventDesc, *Entry);
+        verifyfmod(EventDesc->unloadSampleData());
+    }
+}
+
+void FFMODSampleDataManager::Prefetch(FMOD::Studio::EventDescription *EventDesc)
+{
+    if (EventDesc)
+    {
+        ++FindOrLoad(EventDesc).PrefetchCount;
+    }
+}
+
+void FFMODSampleDataManager::ReleasePrefetch(FMOD::Studio::EventDescription *EventDesc)
+{
+    // The entry may already have been evicted or reset
+    FEntry *Entry = Entries.Find(EventDesc);
+    if (Entry && --Entry->PrefetchCount == 0 && Entry->LoadCount == 0)
+    {
+        Remove(EventDesc, *Entry);
+        verifyfmod(EventDesc->unloadSampleData());
+    }
+}
+
+void FFMODSampleDataManager::Touch(FMOD::Studio::EventDescription *EventDesc)
+{
+    if (FEntry *Entry = Entries.Find(EventDesc))
+    {
+        Entry->LastUsed = ++UseCounter;
+    }
+}
+
+void FFMODSampleDataManager::Update(FFMODEventInstancePool &EventInstancePool)
+{
+    if (!System)
+    {
+        return;
+    }
+
+    bool bLoadCompleted = false;
+    for (auto It = Entries.CreateIterator(); It; ++It)
+    {
+        FEntry &Entry = It.Value();
+        if (!Entry.bLoading)
+        {
+            continue;
+        }
+
+        FMOD_STUDIO_LOADING_STATE State = FMOD_STUDIO_LOADING_STATE_ERROR;
+        if (!It.Key()->isValid() || It.Key()->getSampleLoadingState(&State) != FMOD_OK || State == FMOD_STUDIO_LOADING_STATE_ERROR)
+        {
+            --LoadingCount;
+            It.RemoveCurrent();
+        }
+        else if (State == FMOD_STUDIO_LOADING_STATE_LOADED)
+        {
+            Entry.bLoading = false;
+            --LoadingCount;
+            bLoadCompleted = true;
+        }
+    }
+
+    if (LoadingCount == 0 && bLoadCompleted)
+    {
+        MeasureBatch();
+    }
+
+    while (Budget > 0 && ResidentBytes > Budget)
+    {
+        FMOD::Studio::EventDescription *Oldest = nullptr;
+        FEntry *OldestEntry = nullptr;
+        for (auto &Pair : Entries)
+        {
+            int InstanceCount = 0;
+            if (Pair.Value.bMeasured && Pair.Value.PrefetchCount == 0 && (!OldestEntry || Pair.Value.LastUsed < OldestEntry->LastUsed) &&
+                Pair.Key->getInstanceCount(&InstanceCount) == FMOD_OK && InstanceCount <= EventInstancePool.GetIdleCount(Pair.Key))
+            {
+                Oldest = Pair.Key;
+                OldestEntry = &Pair.Value;
+            }
+        }
+
+        if (!Oldest)
+        {
+            break;
+        }
+        Evict(Oldest, *OldestEntry, EventInstancePool);
+    }
+
+    SET_MEMORY_STAT(STAT_FMOD_SampleData_Managed, ResidentBytes);
+}
+
+void FFMODSampleDataManager::MeasureBatch()
+{
+    TArray<FEntry *, TInlineAllocator<8>> Loaded;
+    for (auto &Pair : Entries)
+    {
+        if (!Pair.Value.bMeasured)
+        {
+            Loaded.Add(&Pair.Value);
+        }
+    }
+    if (Loaded.Num() == 0)
+    {
+        return;
+    }
+
+    const int64 SampleDataBytes = GetSampleDataBytes();
+    if (Budget > 0 && (SampleDataBytes < 0 || (!bSampleDataTracked && SampleDataBytes == 0)))
+    {
+        UE_LOG(LogFMOD, Warning,
+            TEXT("FMOD sample data memory can't be measured, so the Sample Data Budget is disabled. It needs FMOD to allocate through ")
+            TEXT("Unreal (a memory pool size of 0 for the platform), or a logging build with memory tracking enabled."));
+        Budget = 0;
+    }
+
+    // Unloads and unmanaged loads made while the batch was loading are counted towards it too
+    int64 Delta = (SampleDataBytes >= 0 && BatchStartBytes >= 0) ? FMath::Max<int64>(SampleDataBytes - BatchStartBytes, 0) : 0;
+    for (FEntry *Entry : Loaded)
+    {
+        Entry->Bytes = Delta / Loaded.Num();
+        Entry->bMeasured = true;
+        ResidentBytes += Entry->Bytes;
+    }
+}
+
+void FFMODSampleDataManager::Evict(FMOD::Studio::EventDescription *EventDesc, FEntry &Entry, FFMODEventInstancePool &EventInstancePool)
+{
+    UE_LOG(LogFMOD, Verbose, TEXT("Unloading sample data of least recently used event (%lld bytes) to stay within budget of %lld bytes"),
+        Entry.Bytes, Budget);
+    INC_DWORD_STAT(STAT_FMOD_SampleData_Evictions);
+
+    Remove(EventDesc, Entry);
+    EventInstancePool.ReleaseIdle(EventDesc);
+    verifyfmod(EventDesc->unloadSampleData());
+}
+
+void FFMODSampleDataManager::Reset()
+{
+    Entries.Reset();
+    System = nullptr;
+    ResidentBytes = 0;
+    BatchStartBytes = -1;
+    LoadingCount = 0;
+    SET_MEMORY_STAT(STAT_FMOD_SampleData_Managed, 0);
+}
+
+int64 FFMODSampleDataManager::GetSampleDataBytes() const
+{
+    if (bSampleDataTracked)
+    {
+        return TrackedSampleDataBytes.GetValue();
+    }
+
+    // Otherwise sample data memory is only reported by logging builds with memory tracking. Total FMOD allocations would
+    // charge banks, streams and instances to whichever event loaded last, so don't fall back to them
+    FMOD_STUDIO_MEMORY_USAGE Usage = {};
+    if (System && System->getMemoryUsage(&Usage) == FMOD_OK)
+    {
+        return Usage.sampledata;
+    }
+    return -1;
+}
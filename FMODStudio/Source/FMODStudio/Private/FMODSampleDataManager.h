@@ -0,0 +1,123 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace FMOD
+{
+namespace Studio
+{
+class System;
+class EventDescription;
+}
+}
+
+class FFMODEventInstancePool;
+
+/*
+    Keeps event sample data loaded through LoadEventSampleData or prefetched for nearby emitters within a memory
+    budget, unloading the least recently used events when the budget is exceeded. Events with live instances or
+    emitters in prefetch range are never unloaded, though instances idle in the event instance pool don't count.
+
+    Sample data memory is counted by the module's FMOD memory callbacks, which FMOD uses in the editor and whenever the
+    platform's memory pool size is 0. With a fixed memory pool it can only be read from logging builds with memory
+    tracking enabled, and the budget is disabled for other builds. Only the total is known, so the size of each event is
+    the change in sample data memory from just before its load is issued until it finishes. Loads that overlap are
+    measured as one batch and share the change evenly, and anything else loaded or unloaded meanwhile (bank sample data,
+    other systems) is counted towards them.
+
+    Loads are counted per event, and the manager only unloads sample data that it loaded itself.
+*/
+class FFMODSampleDataManager
+{
+public:
+    FFMODSampleDataManager();
+
+    /** Budget in bytes, or 0 for no limit. */
+    void SetBudget(int64 InBudget) { Budget = InBudget; }
+
+    /** The system whose sample data memory is read when allocations aren't tracked. */
+    void SetSystem(FMOD::Studio::System *InSystem) { System = InSystem; }
+
+    /** Called when FMOD allocates through the module's memory callbacks, which then report sample data with TrackAllocation. */
+    static void EnableAllocationTracking();
+    static void TrackAllocation(int64 Bytes);
+
+    /** Loads the sample data of an event, or marks it as recently used if it is already loaded. */
+    void Load(FMOD::Studio::EventDescription *EventDesc);
+
+    /** Releases a Load, unloading the sample data once no loads or prefetches remain. */
+    void Unload(FMOD::Studio::EventDescription *EventDesc);
+
+    /** Loads the sample data of an event for an emitter in prefetch range. Prefetches are counted per event. */
+    void Prefetch(FMOD::Studio::EventDescription *EventDesc);
+
+    /** Releases a prefetch, unloading the sample data once no prefetches or loads remain. */
+    void ReleasePrefetch(FMOD::Studio::EventDescription *EventDesc);
+
+    /** Marks an event as recently used, if its sample data is managed. */
+    void Touch(FMOD::Studio::EventDescription *EventDesc);
+
+    /**
+     * Measures newly loaded sample data and unloads the least recently used events while over budget. Events whose only
+     * instances are idle in the pool can be unloaded, releasing those instances first.
+     */
+    void Update(FFMODEventInstancePool &EventInstancePool);
+
+    /** Forgets all events without unloading them, for when the system that owns them is released. */
+    void Reset();
+
+    int64 GetResidentBytes() const { return ResidentBytes; }
+
+private:
+    struct FEntry
+    {
+        FEntry()
+            : LastUsed(0)
+            , Bytes(0)
+            , LoadCount(0)
+            , PrefetchCount(0)
+            , bLoading(false)
+            , bMeasured(false)
+        {
+        }
+
+        uint64 LastUsed;
+        int64 Bytes;
+
+        /** Number of Load calls not yet matched by Unload. */
+        int32 LoadCount;
+        int32 PrefetchCount;
+
+        /** True until the sample data has finished loading. */
+        bool bLoading;
+
+        /** False until the batch of loads this one belongs to has finished and its size is known. */
+        bool bMeasured;
+    };
+
+    /** Returns the sample data memory allocated by FMOD, or -1 if it can't be measured. */
+    int64 GetSampleDataBytes() const;
+
+    FEntry &FindOrLoad(FMOD::Studio::EventDescription *EventDesc);
+    void Remove(FMOD::Studio::EventDescription *EventDesc, FEntry &Entry);
+
+    /** Shares the change in sample data memory since the batch started between the loads in it. */
+    void MeasureBatch();
+
+    void Evict(FMOD::Studio::EventDescription *EventDesc, FEntry &Entry, FFMODEventInstancePool &EventInstancePool);
+
+    TMap<FMOD::Studio::EventDescription *, FEntry> Entries;
+    FMOD::Studio::System *System;
+    int64 Budget;
+    int64 ResidentBytes;
+
+    /** Sample data memory when the first load of the current batch was issued. */
+    int64 BatchStartBytes;
+
+    /** Number of entries still loading. The batch is measured once this returns to 0. */
+    int32 LoadingCount;
+
+    uint64 UseCounter;
+};
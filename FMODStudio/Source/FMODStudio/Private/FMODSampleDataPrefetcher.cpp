@@ -0,0 +1,106 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#include "FMODSampleDataPrefetcher.h"
+#include "FMODSampleDataManager.h"
+#include "FMODAudioComponent.h"
+#include "FMODEvent.h"
+#include "FMODListener.h"
+#include "fmod_studio.hpp"
+#include "FMODStudioPrivatePCH.h"
+
+FFMODSampleDataPrefetcher::FFMODSampleDataPrefetcher()
+    : Radius(0.0f)
+    , Hysteresis(0.0f)
+{
+}
+
+void FFMODSampleDataPrefetcher::SetRadius(float InRadius, float InHysteresis)
+{
+    Radius = FMath::Max(InRadius, 0.0f);
+    Hysteresis = FMath::Max(InHysteresis, 0.0f);
+}
+
+void FFMODSampleDataPrefetcher::Register(UFMODAudioComponent *Component)
+{
+    if (IsEnabled() && Component && !Entries.Contains(Component))
+    {
+        Entries.Add(Component, nullptr);
+    }
+}
+
+void FFMODSampleDataPrefetcher::Unregister(UFMODAudioComponent *Component, FFMODSampleDataManager &Manager)
+{
+    FMOD::Studio::EventDescription *Prefetched = nullptr;
+    if (Entries.RemoveAndCopyValue(Component, Prefetched) && Prefetched)
+    {
+        Manager.ReleasePrefetch(Prefetched);
+    }
+}
+
+void FFMODSampleDataPrefetcher::Update(
+    FMOD::Studio::System *System, TFunctionRef<FMOD::Studio::EventDescription *(const UFMODEvent *)> FindEventDescription,
+    const FFMODListener *Listeners, int ListenerCount, FFMODSampleDataManager &Manager)
+{
+    if (!System || Entries.Num() == 0)
+    {
+        return;
+    }
+
+    const float EnterDistSq = FMath::Square(Radius);
+    const float LeaveDistSq = FMath::Square(Radius + Hysteresis);
+
+    for (auto It = Entries.CreateIterator(); It; ++It)
+    {
+        FMOD::Studio::EventDescription *&Prefetched = It.Value();
+        UFMODAudioComponent *Component = It.Key().Get();
+        if (!Component)
+        {
+            if (Prefetched)
+            {
+                Manager.ReleasePrefetch(Prefetched);
+            }
+            It.RemoveCurrent();
+            continue;
+        }
+
+        FMOD::Studio::EventDescription *EventDesc = IsValid(Component->Event) ? FindEventDescription(Component->Event) : nullptr;
+
+        // The event may have been changed since it was prefetched
+        if (Prefetched && Prefetched != EventDesc)
+        {
+            Manager.ReleasePrefetch(Prefetched);
+            Prefetched = nullptr;
+        }
+
+        if (!EventDesc)
+        {
+            continue;
+        }
+
+        const FVector Location = Component->GetComponentLocation();
+        float BestDistSq = FLT_MAX;
+        for (int Listener = 0; Listener < ListenerCount; ++Listener)
+        {
+            BestDistSq = FMath::Min(BestDistSq, FVector::DistSquared(Location, Listeners[Listener].Transform.GetTranslation()));
+        }
+
+        if (!Prefetched && BestDistSq <= EnterDistSq)
+        {
+            Manager.Prefetch(EventDesc);
+            Prefetched = EventDesc;
+        }
+        else if (Prefetched && BestDistSq > LeaveDistSq)
+        {
+            Manager.ReleasePrefetch(Prefetched);
+            Prefetched = nullptr;
+        }
+    }
+}
+
+void FFMODSampleDataPrefetcher::Reset()
+{
+    for (auto &Pair : Entries)
+    {
+        Pair.Value = nullptr;
+    }
+}
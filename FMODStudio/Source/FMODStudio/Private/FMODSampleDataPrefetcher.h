@@ -0,0 +1,51 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2024.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Templates/Function.h"
+
+namespace FMOD
+{
+namespace Studio
+{
+class System;
+class EventDescription;
+}
+}
+
+class UFMODAudioComponent;
+class UFMODEvent;
+class FFMODSampleDataManager;
+struct FFMODListener;
+
+/*
+    Prefetches the sample data of events on registered audio components once they come within the prefetch radius of a
+    listener, so they don't load on first play. The sample data is released once the component moves beyond the radius
+    plus the hysteresis distance, or is unregistered.
+*/
+class FFMODSampleDataPrefetcher
+{
+public:
+    FFMODSampleDataPrefetcher();
+
+    void SetRadius(float InRadius, float InHysteresis);
+    bool IsEnabled() const { return Radius > 0.0f; }
+
+    void Register(UFMODAudioComponent *Component);
+    void Unregister(UFMODAudioComponent *Component, FFMODSampleDataManager &Manager);
+
+    /** FindEventDescription should return the cached description for an event, without marking it as used. */
+    void Update(FMOD::Studio::System *System, TFunctionRef<FMOD::Studio::EventDescription *(const UFMODEvent *)> FindEventDescription,
+        const FFMODListener *Listeners, int ListenerCount, FFMODSampleDataManager &Manager);
+
+    /** Forgets all prefetches without releasing them, for when the system that owns them is released. */
+    void Reset();
+
+private:
+    /** The event description prefetched for each registered component, or null if it isn't in range. */
+    TMap<TWeakObjectPtr<UFMODAudioComponent>, FMOD::Studio::EventDescription *> Entries;
+    float Radius;
+    float Hysteresis;
+};
@@ -39,6 +39,17 @@ UFMODSettings::UFMODSettings(const FObjectInitializer &ObjectInitializer)
     : Super(ObjectInitializer)
     , bLoadAllBanks(true)
     , bLoadAllSampleData(false)
+    , bLoadBanksAsynchronously(false)
+    , SampleDataBudget(0)
+    , SampleDataPrefetchRadius(0.0f)
+    , SampleDataPrefetchHysteresis(500.0f)
+    , OcclusionTracesPerFrame(32)
+    , bUseEmitterManager(false)
+    , AudioVolumeQueryDistance(50.0f)
+    , VirtualEmitterUpdateInterval(0.5f)
+    , EventInstancePoolSize(0)
+    , EventInstancePoolWarmSize(0)
+    , ProgrammerSoundCacheBudget(0)
     , bEnableLiveUpdate(true)
     , bEnableEditorLiveUpdate(false)
     , OutputFormat(EFMODSpeakerMode::Surround_5_1)
@@ -51,6 +62,12 @@ UFMODSettings::UFMODSettings(const FObjectInitializer &ObjectInitializer)
     , DSPBufferLength(0)
     , DSPBufferCount(0)
     , FileBufferSize(2048)
+    , FileThreadCount(2)
+    , bMemoryMapBankFiles(false)
+    , bUseAsyncFileReadHandles(false)
+    , FileCacheSize(0)
+    , FileCacheBlockSize(64 * 1024)
+    , FileReadAheadBlocks(2)
     , StudioUpdatePeriod(0)
     , bLockAllBuses(false)
     , LiveUpdatePort(9264)
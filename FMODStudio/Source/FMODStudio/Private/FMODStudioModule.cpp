@@ -5,13 +5,24 @@
 #include "FMODAudioComponent.h"
 #include "FMODBlueprintStatics.h"
 #include "FMODAssetTable.h"
+#include "FMODAudioVolumeCache.h"
+#include "FMODBankManager.h"
+#include "FMODBankManifest.h"
+#include "FMODEmitterManager.h"
+#include "FMODEventInstancePool.h"
 #include "FMODFileCallbacks.h"
+#include "FMODLoadProfiler.h"
+#include "FMODOcclusionScheduler.h"
+#include "FMODProgrammerSoundCache.h"
+#include "FMODSampleDataManager.h"
+#include "FMODSampleDataPrefetcher.h"
 #include "FMODUtils.h"
 #include "FMODEvent.h"
 #include "FMODListener.h"
 #include "FMODSnapshotReverb.h"
 
 #include "Async/Async.h"
+#include "Engine/StreamableManager.h"
 #include "Interfaces/IPluginManager.h"
 #include "Misc/App.h"
 #include "Misc/CommandLine.h"
@@ -22,6 +33,8 @@
 #include "GameFramework/PlayerController.h"
 #include "Containers/Ticker.h"
 #include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "HAL/FileManager.h"
 #include "Runtime/Media/Public/IMediaClock.h"
 #include "Runtime/Media/Public/IMediaClockSink.h"
 #include "Runtime/Media/Public/IMediaModule.h"
@@ -45,7 +58,6 @@
 
 DEFINE_LOG_CATEGORY(LogFMOD);
 
-DECLARE_STATS_GROUP(TEXT("FMOD"), STATGROUP_FMOD, STATCAT_Advanced);
 DECLARE_FLOAT_COUNTER_STAT(TEXT("FMOD CPU - Mixer"), STAT_FMOD_CPUMixer, STATGROUP_FMOD);
 DECLARE_FLOAT_COUNTER_STAT(TEXT("FMOD CPU - Studio"), STAT_FMOD_CPUStudio, STATGROUP_FMOD);
 DECLARE_MEMORY_STAT(TEXT("FMOD Memory - Current"), STAT_FMOD_Current_Memory, STATGROUP_FMOD);
@@ -57,17 +69,60 @@ const TCHAR *FMODSystemContextNames[EFMODSystemContext::Max] = {
     TEXT("Auditioning"), TEXT("Runtime"), TEXT("Editor"),
 };
 
+/** Precedes each FMOD allocation so sample data can be counted when it is freed or reallocated */
+struct alignas(16) FFMODAllocationHeader
+{
+    uint32 Size;
+    bool bSampleData;
+};
+
 void *F_CALLBACK FMODMemoryAlloc(unsigned int size, FMOD_MEMORY_TYPE type, const char *sourcestr)
 {
-    return FMemory::Malloc(size);
+    FFMODAllocationHeader *Header = (FFMODAllocationHeader *)FMemory::Malloc(sizeof(FFMODAllocationHeader) + size);
+    if (!Header)
+    {
+        return nullptr;
+    }
+    Header->Size = size;
+    Header->bSampleData = (type & FMOD_MEMORY_SAMPLEDATA) != 0;
+    if (Header->bSampleData)
+    {
+        FFMODSampleDataManager::TrackAllocation(size);
+    }
+    return Header + 1;
 }
 void *F_CALLBACK FMODMemoryRealloc(void *ptr, unsigned int size, FMOD_MEMORY_TYPE type, const char *sourcestr)
 {
-    return FMemory::Realloc(ptr, size);
+    if (!ptr)
+    {
+        return FMODMemoryAlloc(size, type, sourcestr);
+    }
+    FFMODAllocationHeader *Header = (FFMODAllocationHeader *)ptr - 1;
+    const uint32 OldSize = Header->Size;
+    Header = (FFMODAllocationHeader *)FMemory::Realloc(Header, sizeof(FFMODAllocationHeader) + size);
+    if (!Header)
+    {
+        return nullptr;
+    }
+    Header->Size = size;
+    if (Header->bSampleData)
+    {
+        FFMODSampleDataManager::TrackAllocation((int64)size - OldSize);
+    }
+    return Header + 1;
 }
 void F_CALLBACK FMODMemoryFree(void *ptr, FMOD_MEMORY_TYPE type, const char *sourcestr)
 {
-    FMemory::Free(ptr);
+    if (!ptr)
+    {
+        return;
+    }
+    FFMODAllocationHeader *Header = (FFMODAllocationHeader *)ptr - 1;
+    if (Header->bSampleData)
+    {
+        FFMODSampleDataManager::TrackAllocation(-(int64)Header->Size);
+    }
+    FMemory::Free(Header);
 }
 
 struct FFMODSnapshotEntry
@@ -147,6 +202,67 @@ public:
     FUpdateListenerPosition UpdateListenerPosition;
 };
 
+struct NamedBankEntry
+{
+    NamedBankEntry()
+        : Bank(nullptr)
+        , Result(FMOD_OK)
+        , bComplete(false)
+    {
+    }
+    NamedBankEntry(const FString &InName, FMOD::Studio::Bank *InBank, FMOD_RESULT InResult)
+        : Name(InName)
+        , Bank(InBank)
+        , Result(InResult)
+        , bComplete(false)
+    {
+    }
+
+    FString Name;
+    FMOD::Studio::Bank *Bank;
+    FMOD_RESULT Result;
+    bool bComplete;
+};
+
+/** Banks queued by LoadBanks for one system, completed as they finish loading */
+struct FFMODBankLoadState
+{
+    FFMODBankLoadState()
+        : MasterBank(nullptr)
+        , CompletedCount(0)
+        , bLoadSampleData(false)
+        , bLockBuses(false)
+        , bLoaded(false)
+    {
+    }
+
+    bool IsPending() const { return CompletedCount < Entries.Num(); }
+
+    TArray<NamedBankEntry> Entries;
+    FMOD::Studio::Bank *MasterBank;
+    int32 CompletedCount;
+    bool bLoadSampleData;
+    bool bLockBuses;
+
+    /** True once LoadBanks has finished for the system */
+    bool bLoaded;
+};
+
+#if WITH_EDITOR
+/** Size, timestamp and contents hash of a bank file, used to find the banks that changed when reloading */
+struct FFMODBankFileSignature
+{
+    FFMODBankFileSignature()
+        : Size(0)
+    {
+    }
+
+    int64 Size;
+    FDateTime TimeStamp;
+    FMD5Hash Hash;
+};
+#endif
+
 class FFMODStudioModule : public IFMODStudioModule
 {
 public:
@@ -168,7 +284,12 @@ public:
         for (int i = 0; i < EFMODSystemContext::Max; ++i)
         {
             StudioSystem[i] = nullptr;
+            BankGeneration[i] = 1;
         }
+#if WITH_EDITOR
+        bReloadWhenHashed = false;
+        bReloadRequested = false;
+#endif
     }
 
     void HandleApplicationWillDeactivate()
@@ -194,12 +315,21 @@ public:
     bool LoadLibraries();
 
     void LoadBanks(EFMODSystemContext::Type Type);
+    FMOD_RESULT QueueBankLoad(EFMODSystemContext::Type Type, const FString &Path, FMOD_STUDIO_LOAD_BANK_FLAGS Flags, FMOD::Studio::Bank **Bank);
+    bool UpdateBankLoads(EFMODSystemContext::Type Type);
 
 #if WITH_EDITOR
     FSimpleMulticastDelegate PreEndPIEDelegate;
     FSimpleMulticastDelegate &PreEndPIEEvent() override { return PreEndPIEDelegate; };
     virtual void PreEndPIE() override;
     void ReloadBanks();
+    FSimpleMulticastDelegate BanksReloadedDelegate;
+    FSimpleMulticastDelegate &BanksReloadedEvent() override { return BanksReloadedDelegate; }
+    void ReloadAllBanks();
+    void StartHashingBankFiles(bool bReloadWhenDone);
+    void UpdateBankFileHashing();
+    void ReloadChangedBanks(const TMap<FString, FFMODBankFileSignature> &NewSignatures);
+    void ReloadChangedBanks(EFMODSystemContext::Type Type, const TArray<FString> &ChangedBanks, const TArray<FString> &RemovedBanks);
 #endif
 
     void CreateStudioSystem(EFMODSystemContext::Type Type);
@@ -212,6 +342,9 @@ public:
 
     virtual FMOD::Studio::System *GetStudioSystem(EFMODSystemContext::Type Context) override;
     virtual FMOD::Studio::EventDescription *GetEventDescription(const UFMODEvent *Event, EFMODSystemContext::Type Type) override;
+    FMOD::Studio::EventDescription *FindEventDescription(const UFMODEvent *Event, EFMODSystemContext::Type Context);
+    virtual void InvalidateEventDescriptions(EFMODSystemContext::Type Context) override;
+    virtual TSharedPtr<const FFMODParameterIds> GetParameterIds(FMOD::Studio::EventDescription *EventDesc) override;
     virtual FMOD::Studio::EventInstance *CreateAuditioningInstance(const UFMODEvent *Event) override;
     virtual void StopAuditioningInstance() override;
 
@@ -228,6 +361,7 @@ public:
 
     virtual UFMODAsset *FindAssetByName(const FString &Name) override;
     virtual UFMODEvent *FindEventByName(const FString &Name) override;
+    virtual TSharedPtr<FStreamableHandle> FindAssetByNameAsync(const FString &Name, FFMODAssetFoundDelegate OnFound) override;
     virtual FString GetBankPath(const UFMODBank &Bank) override;
     virtual void GetAllBankPaths(TArray<FString> &Paths, bool IncludeMasterBank) const override;
 
@@ -251,6 +385,41 @@ public:
 
     virtual bool AreBanksLoaded() override;
 
+    virtual float GetBankLoadProgress(EFMODSystemContext::Type Context) override;
+
+    virtual FFMODBankLoadProgressDelegate &BankLoadProgressEvent() override { return BankLoadProgressDelegate; }
+
+    virtual FFMODBanksLoadedDelegate &BanksLoadedEvent() override { return BanksLoadedDelegate; }
+
+    virtual void AcquireBankManifest(const UFMODBankManifest *Manifest) override;
+
+    virtual void ReleaseBankManifest(const UFMODBankManifest *Manifest) override;
+
+    virtual void LoadEventSampleData(const UFMODEvent *Event) override;
+
+    virtual void UnloadEventSampleData(const UFMODEvent *Event) override;
+
+    virtual void RegisterPrefetchComponent(UFMODAudioComponent *Component) override;
+
+    virtual void UnregisterPrefetchComponent(UFMODAudioComponent *Component) override;
+    virtual void RequestOcclusionUpdate(UFMODAudioComponent *Component) override;
+    virtual void CancelOcclusionUpdate(UFMODAudioComponent *Component) override;
+    virtual void RegisterEmitter(UFMODAudioComponent *Component) override;
+    virtual void UnregisterEmitter(UFMODAudioComponent *Component) override;
+    virtual AAudioVolume *FindAudioVolume(UWorld *World, const FVector &Location, const FInteriorSettings *&OutSettings) override;
+    virtual uint32 GetAudioVolumeGeneration() const override { return AudioVolumeCache.GetGeneration(); }
+    virtual void InvalidateAudioVolumes() override { AudioVolumeCache.Invalidate(); }
+    virtual FMOD::Studio::EventInstance *AcquireEventInstance(FMOD::Studio::EventDescription *EventDesc) override;
+    virtual void ReleaseEventInstance(FMOD::Studio::EventInstance *Instance) override;
+
+    virtual FMOD::Sound *AcquireProgrammerSound(const FString &Name, int32 &OutSubsoundIndex) override;
+
+    virtual void ReleaseProgrammerSound(FMOD::Sound *Sound) override;
+
+    virtual void PreloadProgrammerSounds(const TArray<FString> &Names) override;
+
+    virtual void UnloadProgrammerSounds(const TArray<FString> &Names) override;
+
     virtual bool SetLocale(const FString& Locale) override;
 
     virtual FString GetLocale() override;
@@ -280,12 +449,68 @@ public:
     /** Table of assets with name and guid */
     FFMODAssetTable AssetTable;
 
+    /** Incremented whenever banks are unloaded from a system, to invalidate cached event descriptions */
+    uint32 BankGeneration[EFMODSystemContext::Max];
+
+    /** Parameter ids by event description, discarded along with cached event descriptions */
+    TMap<FMOD::Studio::EventDescription *, TSharedPtr<const FFMODParameterIds>> ParameterIds;
+
+    /** Loads assets for FindAssetByNameAsync */
+    FStreamableManager StreamableManager;
+
+    /** Timings of startup stages and bank loads */
+    FFMODLoadProfiler LoadProfiler;
+
     /** List of failed bank files */
     TArray<FString> FailedBankLoads[EFMODSystemContext::Max];
 
+    /** Banks queued by LoadBanks that may still be loading */
+    FFMODBankLoadState BankLoads[EFMODSystemContext::Max];
+
+    FFMODBankLoadProgressDelegate BankLoadProgressDelegate;
+    FFMODBanksLoadedDelegate BanksLoadedDelegate;
+
+    /** Banks loaded through bank manifests, in the runtime system */
+    FFMODBankManager BankManager;
+
+    /** Event sample data loaded through LoadEventSampleData, in the runtime system */
+    FFMODSampleDataManager SampleDataManager;
+
+    /** Audio components whose sample data is prefetched as listeners approach, in the runtime system */
+    FFMODSampleDataPrefetcher SampleDataPrefetcher;
+
+    /** Asynchronous occlusion traces for audio components */
+    FFMODOcclusionScheduler OcclusionScheduler;
+
+    /** Playing audio components updated from the module tick */
+    FFMODEmitterManager EmitterManager;
+
+    /** Spatial index of audio volumes for interior settings lookups */
+    FFMODAudioVolumeCache AudioVolumeCache;
+
+    /** Stopped event instances kept for reuse */
+    FFMODEventInstancePool EventInstancePool;
+
+    /** Programmer sounds shared between instances and kept for reuse */
+    FFMODProgrammerSoundCache ProgrammerSoundCache;
+
     /** List of required plugins we found when loading banks. */
     TArray<FString> RequiredPlugins;
 
+#if WITH_EDITOR
+    /** Bank files as of the last ReloadBanks, by full path */
+    TMap<FString, FFMODBankFileSignature> BankFileSignatures;
+
+    /** Signatures of the current bank files, computed on a worker thread */
+    TFuture<TMap<FString, FFMODBankFileSignature>> BankFileHashTask;
+
+    /** True if the banks should be reloaded once BankFileHashTask completes, rather than just recording signatures */
+    bool bReloadWhenHashed;
+
+    /** True if ReloadBanks was called while BankFileHashTask was running */
+    bool bReloadRequested;
+#endif
+
 /** Listener information */
 #if FMOD_VERSION >= 0x00010600
     static const int MAX_LISTENERS = FMOD_MAX_LISTENERS;
@@ -341,6 +566,7 @@ void FFMODStudioModule::LogError(int result, const char *function)
 bool FFMODStudioModule::LoadPlugin(EFMODSystemContext::Type Context, const TCHAR *ShortName)
 {
     UE_LOG(LogFMOD, Log, TEXT("Loading plugin '%s'"), ShortName);
+    FMOD_LOAD_PROFILE_SCOPE(LoadProfiler, FString::Printf(TEXT("LoadPlugin (%s)"), ShortName));
 
     static const int ATTEMPT_COUNT = 2;
     static const TCHAR *AttemptPrefixes[ATTEMPT_COUNT] = {
@@ -478,7 +704,23 @@ void FFMODStudioModule::StartupModule()
         bAllowLiveUpdate = false;
     }
 
-    if (LoadLibraries())
+    FString LoadProfilePath;
+    if (FParse::Value(FCommandLine::Get(), TEXT("FMODLoadProfile="), LoadProfilePath) || FParse::Param(FCommandLine::Get(), TEXT("FMODLoadProfile")))
+    {
+        if (LoadProfilePath.IsEmpty())
+        {
+            LoadProfilePath = FPaths::ProfilingDir() / TEXT("FMODLoadProfile.json");
+        }
+        LoadProfiler.SetOutputPath(LoadProfilePath);
+    }
+
+    bool bLibrariesLoaded = false;
+    {
+        FMOD_LOAD_PROFILE_SCOPE(LoadProfiler, TEXT("LoadLibraries"));
+        bLibrariesLoaded = LoadLibraries();
+    }
+
+    if (bLibrariesLoaded)
     {
         verifyfmod(FMOD::Debug_Initialize(FMOD_DEBUG_LEVEL_WARNING, FMOD_DEBUG_MODE_CALLBACK, FMODLogCallback));
 
@@ -505,20 +747,34 @@ void FFMODStudioModule::StartupModule()
         else
         {
             verifyfmod(FMOD::Memory_Initialize(0, 0, FMODMemoryAlloc, FMODMemoryRealloc, FMODMemoryFree));
+            FFMODSampleDataManager::EnableAllocationTracking();
         }
 
 #if defined(FMOD_PLATFORM_HEADER)
         verifyfmod(FMODPlatformSystemSetup());
 #endif
 
-        AcquireFMODFileSystem();
+        AcquireFMODFileSystem(Settings);
 
         if (GIsEditor)
         {
-            AssetTable.Load();
+            {
+                FMOD_LOAD_PROFILE_SCOPE(LoadProfiler, TEXT("FFMODAssetTable::Load"));
+                AssetTable.Load();
+            }
             AssetTable.SetLocale(GetDefaultLocale());
             CreateStudioSystem(EFMODSystemContext::Auditioning);
             CreateStudioSystem(EFMODSystemContext::Editor);
+#if WITH_EDITOR
+            if (!IsRunningCommandlet() && FApp::HasProjectName())
+            {
+                // Load the banks now and record their files in the background, so the first ReloadBanks only
+                // reloads the banks that have changed since startup
+                LoadBanks(EFMODSystemContext::Auditioning);
+                LoadBanks(EFMODSystemContext::Editor);
+                StartHashingBankFiles(false);
+            }
+#endif
         }
         else
         {
@@ -528,6 +784,7 @@ void FFMODStudioModule::StartupModule()
 
     OnTick = FTickerDelegate::CreateRaw(this, &FFMODStudioModule::Tick);
     TickDelegateHandle = FTicker::GetCoreTicker().AddTicker(OnTick);
+    AudioVolumeCache.Init();
 }
 
 inline FMOD_SPEAKERMODE ConvertSpeakerMode(EFMODSpeakerMode::Type Mode)
@@ -594,9 +851,19 @@ void FFMODStudioModule::CreateStudioSystem(EFMODSystemContext::Type Type)
     }
 
     UE_LOG(LogFMOD, Verbose, TEXT("CreateStudioSystem for context %s"), FMODSystemContextNames[Type]);
+    FMOD_LOAD_PROFILE_SCOPE(LoadProfiler, FString::Printf(TEXT("CreateStudioSystem (%s)"), FMODSystemContextNames[Type]));
 
     const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
     bLoadAllSampleData = Settings.bLoadAllSampleData;
+    OcclusionScheduler.SetBudget(Settings.OcclusionTracesPerFrame);
+    EventInstancePool.SetPoolSize(Settings.EventInstancePoolSize, Settings.EventInstancePoolWarmSize);
+
+    if (Type == EFMODSystemContext::Runtime)
+    {
+        SampleDataManager.SetBudget(Settings.SampleDataBudget);
+        ProgrammerSoundCache.SetBudget(Settings.ProgrammerSoundCacheBudget);
+        SampleDataPrefetcher.SetRadius(Settings.SampleDataPrefetchRadius, Settings.SampleDataPrefetchHysteresis);
+    }
 
     FMOD_STUDIO_INITFLAGS StudioInitFlags = FMOD_STUDIO_INIT_NORMAL;
     FMOD_INITFLAGS InitFlags = FMOD_INIT_NORMAL;
@@ -736,6 +1003,10 @@ void FFMODStudioModule::CreateStudioSystem(EFMODSystemContext::Type Type)
     verifyfmod(StudioSystem[Type]->setAdvancedSettings(&advStudioSettings));
 
     verifyfmod(StudioSystem[Type]->initialize(Settings.TotalChannelCount, StudioInitFlags, InitFlags, InitData));
+    if (Type == EFMODSystemContext::Runtime)
+    {
+        SampleDataManager.SetSystem(StudioSystem[Type]);
+    }
 
     for (FString PluginName : Settings.PluginFiles)
     {
@@ -839,15 +1110,55 @@ void FFMODStudioModule::DestroyStudioSystem(EFMODSystemContext::Type Type)
         }
     }
 
+    if (Type == EFMODSystemContext::Runtime)
+    {
+        // Cached sounds belong to the core system, so they must be released first
+        ProgrammerSoundCache.Reset();
+    }
+
     if (StudioSystem[Type])
     {
         verifyfmod(StudioSystem[Type]->release());
         StudioSystem[Type] = nullptr;
     }
+
+    BankLoads[Type] = FFMODBankLoadState();
+    LoadProfiler.CancelPending(FMODSystemContextNames[Type]);
+    InvalidateEventDescriptions(Type);
+    if (Type == EFMODSystemContext::Runtime)
+    {
+        BankManager.Reset();
+        SampleDataManager.Reset();
+        SampleDataPrefetcher.Reset();
+    }
 }
 
 bool FFMODStudioModule::Tick(float DeltaTime)
 {
+    for (int i = 0; i < EFMODSystemContext::Max; ++i)
+    {
+        if (BankLoads[i].IsPending())
+        {
+            UpdateBankLoads((EFMODSystemContext::Type)i);
+        }
+    }
+
+    LoadProfiler.Update();
+    BankManager.Update();
+#if WITH_EDITOR
+    UpdateBankFileHashing();
+#endif
+
+    SampleDataPrefetcher.Update(StudioSystem[EFMODSystemContext::Runtime],
+        [this](const UFMODEvent *Event) { return FindEventDescription(Event, EFMODSystemContext::Runtime); }, Listeners, ListenerCount,
+        SampleDataManager);
+    SampleDataManager.Update(EventInstancePool);
+    AudioVolumeCache.Update();
+    EmitterManager.Update();
+    EventInstancePool.Update();
+    ProgrammerSoundCache.Update();
+    OcclusionScheduler.Update(Listeners, ListenerCount);
+
     if (ClockSinks[EFMODSystemContext::Auditioning].IsValid())
     {
         verifyfmod(ClockSinks[EFMODSystemContext::Auditioning]->LastResult);
@@ -999,9 +1310,8 @@ void FFMODStudioModule::SetListenerPosition(int ListenerIndex, UWorld *World, co
 
         FVector ListenerPos = ListenerTransform.GetTranslation();
 
-        FInteriorSettings *InteriorSettings =
-            (FInteriorSettings *)alloca(sizeof(FInteriorSettings)); // FinteriorSetting::FInteriorSettings() isn't exposed (possible UE4 bug???)
-        AAudioVolume *Volume = World->GetAudioSettings(ListenerPos, NULL, InteriorSettings);
+        const FInteriorSettings *InteriorSettings = nullptr;
+        AAudioVolume *Volume = AudioVolumeCache.Find(World, ListenerPos, InteriorSettings);
 
         Listeners[ListenerIndex].Velocity =
             DeltaSeconds > 0.f ? (ListenerTransform.GetTranslation() - Listeners[ListenerIndex].Transform.GetTranslation()) / DeltaSeconds :
@@ -1163,7 +1473,10 @@ void FFMODStudioModule::SetInPIE(bool bInPIE, bool simulating)
         // TODO: Stop sounds for the Editor system? What should happen if the user previews a sequence with transport
         // controls then starts a PIE session? What does happen?
 
-        AssetTable.Load();
+        {
+            FMOD_LOAD_PROFILE_SCOPE(LoadProfiler, TEXT("FFMODAssetTable::Load"));
+            AssetTable.Load();
+        }
         AssetTable.SetLocale(GetDefaultLocale());
 
         ListenerCount = 1;
@@ -1195,6 +1508,22 @@ UFMODEvent *FFMODStudioModule::FindEventByName(const FString &Name)
     return Cast<UFMODEvent>(Asset);
 }
 
+TSharedPtr<FStreamableHandle> FFMODStudioModule::FindAssetByNameAsync(const FString &Name, FFMODAssetFoundDelegate OnFound)
+{
+    FSoftObjectPath AssetPath = AssetTable.GetAssetPathByStudioPath(Name);
+    UObject *Asset = AssetPath.ResolveObject();
+
+    if (Asset || AssetPath.IsNull())
+    {
+        OnFound.ExecuteIfBound(Cast<UFMODAsset>(Asset));
+        return nullptr;
+    }
+
+    return StreamableManager.RequestAsyncLoad(AssetPath, FStreamableDelegate::CreateLambda([AssetPath, OnFound]() {
+        OnFound.ExecuteIfBound(Cast<UFMODAsset>(AssetPath.ResolveObject()));
+    }));
+}
+
 FString FFMODStudioModule::GetBankPath(const UFMODBank &Bank)
 {
     FString BankPath = AssetTable.GetBankPath(Bank);
@@ -1273,6 +1602,7 @@ void FFMODStudioModule::ShutdownModule()
     {
         // Unregister tick function.
         FTicker::GetCoreTicker().RemoveTicker(TickDelegateHandle);
+        AudioVolumeCache.Shutdown();
     }
 
     UE_LOG(LogFMOD, Verbose, TEXT("FFMODStudioModule unloading dynamic libraries"));
@@ -1289,27 +1619,156 @@ void FFMODStudioModule::ShutdownModule()
     UE_LOG(LogFMOD, Verbose, TEXT("FFMODStudioModule finished unloading"));
 }
 
-struct NamedBankEntry
+bool FFMODStudioModule::AreBanksLoaded()
 {
-    NamedBankEntry()
-        : Bank(nullptr)
+    return bBanksLoaded;
+}
+
+void FFMODStudioModule::AcquireBankManifest(const UFMODBankManifest *Manifest)
+{
+    if (IsValid(Manifest))
     {
+        BankManager.Acquire(StudioSystem[EFMODSystemContext::Runtime], *Manifest);
     }
-    NamedBankEntry(const FString &InName, FMOD::Studio::Bank *InBank, FMOD_RESULT InResult)
-        : Name(InName)
-        , Bank(InBank)
-        , Result(InResult)
+}
+
+void FFMODStudioModule::ReleaseBankManifest(const UFMODBankManifest *Manifest)
+{
+    if (IsValid(Manifest))
     {
+        if (BankManager.Release(*Manifest))
+        {
+            InvalidateEventDescriptions(EFMODSystemContext::Runtime);
+        }
     }
+}
 
-    FString Name;
-    FMOD::Studio::Bank *Bank;
-    FMOD_RESULT Result;
-};
+void FFMODStudioModule::LoadEventSampleData(const UFMODEvent *Event)
+{
+    FMOD::Studio::EventDescription *EventDesc = GetEventDescription(Event);
+    if (EventDesc == nullptr)
+    {
+        return;
+    }
 
-bool FFMODStudioModule::AreBanksLoaded()
+    if (bIsInPIE)
+    {
+        SampleDataManager.Load(EventDesc);
+    }
+    else
+    {
+        verifyfmod(EventDesc->loadSampleData());
+    }
+}
+
+void FFMODStudioModule::UnloadEventSampleData(const UFMODEvent *Event)
 {
-    return bBanksLoaded;
+    FMOD::Studio::EventDescription *EventDesc = GetEventDescription(Event);
+    if (EventDesc == nullptr)
+    {
+        return;
+    }
+
+    if (bIsInPIE)
+    {
+        SampleDataManager.Unload(EventDesc);
+    }
+    else
+    {
+        verifyfmod(EventDesc->unloadSampleData());
+    }
+}
+
+void FFMODStudioModule::RegisterPrefetchComponent(UFMODAudioComponent *Component)
+{
+    SampleDataPrefetcher.Register(Component);
+}
+
+void FFMODStudioModule::UnregisterPrefetchComponent(UFMODAudioComponent *Component)
+{
+    SampleDataPrefetcher.Unregister(Component, SampleDataManager);
+}
+
+void FFMODStudioModule::RequestOcclusionUpdate(UFMODAudioComponent *Component)
+{
+    OcclusionScheduler.Request(Component);
+}
+
+void FFMODStudioModule::CancelOcclusionUpdate(UFMODAudioComponent *Component)
+{
+    OcclusionScheduler.Cancel(Component);
+}
+
+void FFMODStudioModule::RegisterEmitter(UFMODAudioComponent *Component)
+{
+    EmitterManager.Register(Component);
+}
+
+void FFMODStudioModule::UnregisterEmitter(UFMODAudioComponent *Component)
+{
+    EmitterManager.Unregister(Component);
+}
+
+FMOD::Studio::EventInstance *FFMODStudioModule::AcquireEventInstance(FMOD::Studio::EventDescription *EventDesc)
+{
+    return EventDesc ? EventInstancePool.Acquire(EventDesc) : nullptr;
+}
+
+void FFMODStudioModule::ReleaseEventInstance(FMOD::Studio::EventInstance *Instance)
+{
+    if (Instance)
+    {
+        EventInstancePool.Release(Instance);
+    }
+}
+
+FMOD::Sound *FFMODStudioModule::AcquireProgrammerSound(const FString &Name, int32 &OutSubsoundIndex)
+{
+    FMOD::Studio::System *System = GetStudioSystem(EFMODSystemContext::Max);
+    if (System == nullptr || Name.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    // Only the runtime system lives long enough to be worth caching for
+    const bool bCache = (System == StudioSystem[EFMODSystemContext::Runtime]);
+    return ProgrammerSoundCache.Acquire(System, Name, OutSubsoundIndex, bCache);
+}
+
+void FFMODStudioModule::ReleaseProgrammerSound(FMOD::Sound *Sound)
+{
+    if (Sound)
+    {
+        ProgrammerSoundCache.Release(Sound);
+    }
+}
+
+void FFMODStudioModule::PreloadProgrammerSounds(const TArray<FString> &Names)
+{
+    if (StudioSystem[EFMODSystemContext::Runtime])
+    {
+        ProgrammerSoundCache.Preload(StudioSystem[EFMODSystemContext::Runtime], Names);
+    }
+}
+
+void FFMODStudioModule::UnloadProgrammerSounds(const TArray<FString> &Names)
+{
+    ProgrammerSoundCache.Unload(Names);
+}
+
+AAudioVolume *FFMODStudioModule::FindAudioVolume(UWorld *World, const FVector &Location, const FInteriorSettings *&OutSettings)
+{
+    return AudioVolumeCache.Find(World, Location, OutSettings);
+}
+
+float FFMODStudioModule::GetBankLoadProgress(EFMODSystemContext::Type Context)
+{
+    const FFMODBankLoadState &LoadState = BankLoads[Context];
+    if (LoadState.Entries.Num() > 0)
+    {
+        return (float)LoadState.CompletedCount / LoadState.Entries.Num();
+    }
+    return (StudioSystem[Context] && LoadState.bLoaded) ? 1.0f : 0.0f;
 }
 
 bool FFMODStudioModule::SetLocale(const FString& LocaleName)
@@ -1320,6 +1779,11 @@ bool FFMODStudioModule::SetLocale(const FString& LocaleName)
     {
         if (Locale.LocaleName == LocaleName)
         {
+            if (Locale.LocaleCode != AssetTable.GetLocale())
+            {
+                // Audio table keys will resolve to the new locale's sounds once its bank is loaded
+                ProgrammerSoundCache.ResetAudioTables();
+            }
             AssetTable.SetLocale(Locale.LocaleCode);
             return true;
         }
@@ -1360,24 +1824,33 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
     const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
 
     FailedBankLoads[Type].Reset();
+    BankLoads[Type] = FFMODBankLoadState();
     if (Type == EFMODSystemContext::Auditioning || Type == EFMODSystemContext::Editor)
     {
         RequiredPlugins.Reset();
     }
 
+    bool bLoadAsynchronously = false;
+
     if (StudioSystem[Type] != nullptr && Settings.IsBankPathSet())
     {
         UE_LOG(LogFMOD, Verbose, TEXT("LoadBanks for context %s"), FMODSystemContextNames[Type]);
+        FMOD_LOAD_PROFILE_SCOPE(LoadProfiler, FString::Printf(TEXT("LoadBanks (%s)"), FMODSystemContextNames[Type]));
 
         /*
-            Queue up all banks to load asynchronously then wait at the end.
+            Queue up all banks to load asynchronously then either wait at the end, or let Tick complete them.
         */
         bool bLoadAllBanks = ((Type == EFMODSystemContext::Auditioning) || (Type == EFMODSystemContext::Editor) || Settings.bLoadAllBanks);
         bool bLoadSampleData = ((Type == EFMODSystemContext::Runtime) && Settings.bLoadAllSampleData);
         bool bLockAllBuses = ((Type == EFMODSystemContext::Runtime) && Settings.bLockAllBuses);
-        FMOD_STUDIO_LOAD_BANK_FLAGS BankFlags = (bLockAllBuses ? FMOD_STUDIO_LOAD_BANK_NORMAL : FMOD_STUDIO_LOAD_BANK_NONBLOCKING);
+        bLoadAsynchronously = ((Type == EFMODSystemContext::Runtime) && Settings.bLoadBanksAsynchronously);
+
+        // Buses can only be locked once the master bank has loaded, which is waited for here unless loading asynchronously
+        FMOD_STUDIO_LOAD_BANK_FLAGS BankFlags = ((bLockAllBuses && !bLoadAsynchronously) ? FMOD_STUDIO_LOAD_BANK_NORMAL : FMOD_STUDIO_LOAD_BANK_NONBLOCKING);
         FMOD_RESULT Result = FMOD_OK;
-        TArray<NamedBankEntry> BankEntries;
+        FFMODBankLoadState &LoadState = BankLoads[Type];
+        LoadState.bLoadSampleData = bLoadSampleData;
+        LoadState.bLockBuses = bLockAllBuses;
 
         // Always load the master bank at startup
         FMOD::Studio::Bank *MasterBank = nullptr;
@@ -1392,8 +1865,8 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
         {
             FString MasterBankPath = Settings.GetFullBankPath() / AssetTable.GetMasterBankPath();
             UE_LOG(LogFMOD, Verbose, TEXT("Loading master bank: %s"), *MasterBankPath);
-            Result = StudioSystem[Type]->loadBankFile(TCHAR_TO_UTF8(*MasterBankPath), BankFlags, &MasterBank);
-            BankEntries.Add(NamedBankEntry(MasterBankPath, MasterBank, Result));
+            Result = QueueBankLoad(Type, MasterBankPath, BankFlags, &MasterBank);
+            LoadState.MasterBank = MasterBank;
         }
 
         if (Result == FMOD_OK && !AssetTable.GetMasterAssetsBankPath().IsEmpty())
@@ -1402,8 +1875,7 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
             FString MasterAssetsBankPath = Settings.GetFullBankPath() / AssetTable.GetMasterAssetsBankPath();
             if (FPaths::FileExists(MasterAssetsBankPath))
             {
-                Result = StudioSystem[Type]->loadBankFile(TCHAR_TO_UTF8(*MasterAssetsBankPath), BankFlags, &MasterAssetsBank);
-                BankEntries.Add(NamedBankEntry(MasterAssetsBankPath, MasterAssetsBank, Result));
+                Result = QueueBankLoad(Type, MasterAssetsBankPath, BankFlags, &MasterAssetsBank);
             }
         }
 
@@ -1416,8 +1888,7 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
                 FString StringsBankPath = Settings.GetFullBankPath() / AssetTable.GetMasterStringsBankPath();
                 UE_LOG(LogFMOD, Verbose, TEXT("Loading strings bank: %s"), *StringsBankPath);
                 FMOD::Studio::Bank *StringsBank = nullptr;
-                Result = StudioSystem[Type]->loadBankFile(TCHAR_TO_UTF8(*StringsBankPath), BankFlags, &StringsBank);
-                BankEntries.Add(NamedBankEntry(StringsBankPath, StringsBank, Result));
+                Result = QueueBankLoad(Type, StringsBankPath, BankFlags, &StringsBank);
             }
 
             // Optionally load all banks in the directory
@@ -1436,22 +1907,94 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
                     UE_LOG(LogFMOD, Log, TEXT("Loading bank: %s"), *OtherFile);
 
                     FMOD::Studio::Bank *OtherBank;
-                    Result = StudioSystem[Type]->loadBankFile(TCHAR_TO_UTF8(*OtherFile), BankFlags, &OtherBank);
-                    BankEntries.Add(NamedBankEntry(OtherFile, OtherBank, Result));
+                    Result = QueueBankLoad(Type, OtherFile, BankFlags, &OtherBank);
                 }
             }
+        }
+
+        if (!bLoadAsynchronously)
+        {
+            // Wait for all banks to load.
+            StudioSystem[Type]->flushCommands();
+        }
+    }
+
+    if (bLoadAsynchronously)
+    {
+        UE_LOG(LogFMOD, Verbose, TEXT("Loading %d banks asynchronously"), BankLoads[Type].Entries.Num());
+        bBanksLoaded = false;
+        UpdateBankLoads(Type);
+    }
+    else
+    {
+        UpdateBankLoads(Type);
+        if (BankLoads[Type].bLockBuses && StudioSystem[Type])
+        {
+            // Make sure the locked buses have been created before returning
+            StudioSystem[Type]->flushCommands();
+        }
+        bBanksLoaded = true;
+    }
+}
+
+FMOD_RESULT FFMODStudioModule::QueueBankLoad(
+    EFMODSystemContext::Type Type, const FString &Path, FMOD_STUDIO_LOAD_BANK_FLAGS Flags, FMOD::Studio::Bank **Bank)
+{
+    LoadProfiler.BeginBank(FMODSystemContextNames[Type], Path);
+
+    FMOD::Studio::Bank *LoadedBank = nullptr;
+    FMOD_RESULT Result = StudioSystem[Type]->loadBankFile(TCHAR_TO_UTF8(*Path), Flags, &LoadedBank);
+    BankLoads[Type].Entries.Add(NamedBankEntry(Path, LoadedBank, Result));
+    if (Bank)
+    {
+        *Bank = LoadedBank;
+    }
+    return Result;
+}
+
+bool FFMODStudioModule::UpdateBankLoads(EFMODSystemContext::Type Type)
+{
+    FFMODBankLoadState &LoadState = BankLoads[Type];
+    const bool bWasPending = LoadState.IsPending();
+
+    for (NamedBankEntry &Entry : LoadState.Entries)
+    {
+        if (Entry.bComplete)
+        {
+            continue;
+        }
+
+        if (Entry.Result == FMOD_OK)
+        {
+            FMOD_STUDIO_LOADING_STATE BankLoadingState = FMOD_STUDIO_LOADING_STATE_ERROR;
+            Entry.Result = Entry.Bank->getLoadingState(&BankLoadingState);
+            if (Entry.Result == FMOD_OK && BankLoadingState == FMOD_STUDIO_LOADING_STATE_LOADING)
+            {
+                continue;
+            }
+
+            if (BankLoadingState == FMOD_STUDIO_LOADING_STATE_ERROR)
+            {
+                Entry.Bank->unload();
+                Entry.Bank = nullptr;
+            }
+            else if (LoadState.bLoadSampleData)
+            {
+                verifyfmod(Entry.Bank->loadSampleData());
+                LoadProfiler.BeginSampleData(FMODSystemContextNames[Type], Entry.Name, Entry.Bank);
+            }
 
             // Optionally lock all buses to make sure they are created
-            if (MasterBank && bLockAllBuses)
+            if (Entry.Bank && Entry.Bank == LoadState.MasterBank && LoadState.bLockBuses)
             {
                 UE_LOG(LogFMOD, Verbose, TEXT("Locking all buses"));
                 int BusCount = 0;
-                verifyfmod(MasterBank->getBusCount(&BusCount));
+                verifyfmod(Entry.Bank->getBusCount(&BusCount));
                 if (BusCount != 0)
                 {
                     TArray<FMOD::Studio::Bus *> BusList;
                     BusList.AddZeroed(BusCount);
-                    verifyfmod(MasterBank->getBusList(BusList.GetData(), BusCount, &BusCount));
+                    verifyfmod(Entry.Bank->getBusList(BusList.GetData(), BusCount, &BusCount));
                     BusList.SetNum(BusCount);
                     for (int BusIdx = 0; BusIdx < BusCount; ++BusIdx)
                     {
@@ -1461,52 +2004,74 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
             }
         }
 
-        // Wait for all banks to load.
-        StudioSystem[Type]->flushCommands();
+        Entry.bComplete = true;
+        ++LoadState.CompletedCount;
 
-        for (NamedBankEntry &Entry : BankEntries)
+        bool bSucceeded = (Entry.Bank != nullptr && Entry.Result == FMOD_OK);
+        LoadProfiler.EndBank(FMODSystemContextNames[Type], Entry.Name, bSucceeded);
+        if (!bSucceeded)
         {
-            if (Entry.Result == FMOD_OK)
+            FString ErrorMessage;
+            if (!FPaths::FileExists(Entry.Name))
             {
-                FMOD_STUDIO_LOADING_STATE BankLoadingState = FMOD_STUDIO_LOADING_STATE_ERROR;
-                Entry.Result = Entry.Bank->getLoadingState(&BankLoadingState);
-                if (BankLoadingState == FMOD_STUDIO_LOADING_STATE_ERROR)
-                {
-                    Entry.Bank->unload();
-                    Entry.Bank = nullptr;
-                }
-                else if (bLoadSampleData)
-                {
-                    verifyfmod(Entry.Bank->loadSampleData());
-                }
+                ErrorMessage = "File does not exist";
             }
-            if (Entry.Bank == nullptr || Entry.Result != FMOD_OK)
+            else
             {
-                FString ErrorMessage;
-                if (!FPaths::FileExists(Entry.Name))
-                {
-                    ErrorMessage = "File does not exist";
-                }
-                else
-                {
-                    ErrorMessage = UTF8_TO_TCHAR(FMOD_ErrorString(Entry.Result));
-                }
-                UE_LOG(LogFMOD, Warning, TEXT("Failed to load bank: %s (%s)"), *Entry.Name, *ErrorMessage);
-                FailedBankLoads[Type].Add(FString::Printf(TEXT("%s (%s)"), *FPaths::GetBaseFilename(Entry.Name), *ErrorMessage));
+                ErrorMessage = UTF8_TO_TCHAR(FMOD_ErrorString(Entry.Result));
             }
+            UE_LOG(LogFMOD, Warning, TEXT("Failed to load bank: %s (%s)"), *Entry.Name, *ErrorMessage);
+            FailedBankLoads[Type].Add(FString::Printf(TEXT("%s (%s)"), *FPaths::GetBaseFilename(Entry.Name), *ErrorMessage));
         }
+
+        BankLoadProgressDelegate.Broadcast(Type, Entry.Name, bSucceeded, GetBankLoadProgress(Type));
     }
 
-    bBanksLoaded = true;
+    if (LoadState.IsPending())
+    {
+        return false;
+    }
+
+    if (bWasPending || LoadState.Entries.Num() == 0)
+    {
+        LoadState.bLoaded = true;
+        if (Type == EFMODSystemContext::Runtime)
+        {
+            bBanksLoaded = true;
+        }
+        BanksLoadedDelegate.Broadcast(Type);
+    }
+    return true;
 }
 
 #if WITH_EDITOR
 void FFMODStudioModule::ReloadBanks()
 {
-    UE_LOG(LogFMOD, Verbose, TEXT("Refreshing auditioning system"));
-
     AssetTable.Load();
 
+    if (BankFileHashTask.IsValid())
+    {
+        bReloadRequested = true;
+        return;
+    }
+
+    if (BankFileSignatures.Num() == 0)
+    {
+        // No bank files were recorded at startup, so there is nothing to compare against. Load everything now and
+        // record the bank files in the background
+        ReloadAllBanks();
+        StartHashingBankFiles(false);
+        return;
+    }
+
+    // Hashing every bank can take a while, so do it on a worker and reload the changed banks once it completes
+    StartHashingBankFiles(true);
+}
+
+void FFMODStudioModule::ReloadAllBanks()
+{
+    UE_LOG(LogFMOD, Verbose, TEXT("Refreshing auditioning system"));
+
     DestroyStudioSystem(EFMODSystemContext::Auditioning);
     CreateStudioSystem(EFMODSystemContext::Auditioning);
     LoadBanks(EFMODSystemContext::Auditioning);
@@ -1514,6 +2079,166 @@ void FFMODStudioModule::ReloadBanks()
     DestroyStudioSystem(EFMODSystemContext::Editor);
     CreateStudioSystem(EFMODSystemContext::Editor);
     LoadBanks(EFMODSystemContext::Editor);
+
+    BanksReloadedDelegate.Broadcast();
+}
+
+void FFMODStudioModule::StartHashingBankFiles(bool bReloadWhenDone)
+{
+    TArray<FString> BankPaths;
+    AssetTable.GetAllBankPaths(BankPaths, true);
+
+    bReloadWhenHashed = bReloadWhenDone;
+    BankFileHashTask = Async(EAsyncExecution::ThreadPool, [BankPaths = MoveTemp(BankPaths), OldSignatures = BankFileSignatures]() {
+        IFileManager &FileManager = IFileManager::Get();
+        TMap<FString, FFMODBankFileSignature> NewSignatures;
+
+        for (const FString &Path : BankPaths)
+        {
+            FFMODBankFileSignature Signature;
+            Signature.Size = FileManager.FileSize(*Path);
+            Signature.TimeStamp = FileManager.GetTimeStamp(*Path);
+
+            // Files that haven't been touched keep their hash, but Studio rewrites every bank on a build so most are hashed
+            const FFMODBankFileSignature *OldSignature = OldSignatures.Find(Path);
+            if (OldSignature && OldSignature->Size == Signature.Size && OldSignature->TimeStamp == Signature.TimeStamp)
+            {
+                Signature.Hash = OldSignature->Hash;
+            }
+            else
+            {
+                Signature.Hash = FMD5Hash::HashFile(*Path);
+            }
+
+            NewSignatures.Add(Path, Signature);
+        }
+
+        return NewSignatures;
+    });
+}
+
+void FFMODStudioModule::UpdateBankFileHashing()
+{
+    if (!BankFileHashTask.IsValid() || !BankFileHashTask.IsReady())
+    {
+        return;
+    }
+
+    TMap<FString, FFMODBankFileSignature> NewSignatures = BankFileHashTask.Get();
+    BankFileHashTask.Reset();
+
+    if (bReloadWhenHashed)
+    {
+        ReloadChangedBanks(NewSignatures);
+    }
+    else
+    {
+        BankFileSignatures = MoveTemp(NewSignatures);
+    }
+
+    if (bReloadRequested)
+    {
+        bReloadRequested = false;
+        StartHashingBankFiles(true);
+    }
+}
+
+void FFMODStudioModule::ReloadChangedBanks(const TMap<FString, FFMODBankFileSignature> &NewSignatures)
+{
+    TArray<FString> ChangedBanks, RemovedBanks;
+    for (const TPair<FString, FFMODBankFileSignature> &NewSignature : NewSignatures)
+    {
+        const FFMODBankFileSignature *OldSignature = BankFileSignatures.Find(NewSignature.Key);
+        if (!OldSignature || !(OldSignature->Hash == NewSignature.Value.Hash))
+        {
+            ChangedBanks.Add(NewSignature.Key);
+        }
+    }
+    for (const TPair<FString, FFMODBankFileSignature> &OldSignature : BankFileSignatures)
+    {
+        if (!NewSignatures.Contains(OldSignature.Key))
+        {
+            RemovedBanks.Add(OldSignature.Key);
+        }
+    }
+    BankFileSignatures = NewSignatures;
+
+    // The master and strings banks hold the bus hierarchy and path table everything else depends on, so changes
+    // to those still need a full reload
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    TArray<FString> MasterBankPaths;
+    for (const FString &Path : { AssetTable.GetMasterBankPath(), AssetTable.GetMasterStringsBankPath(), AssetTable.GetMasterAssetsBankPath() })
+    {
+        if (!Path.IsEmpty())
+        {
+            MasterBankPaths.Add(Settings.GetFullBankPath() / Path);
+        }
+    }
+    auto IsMasterBank = [&MasterBankPaths](const FString &Path) { return MasterBankPaths.Contains(Path); };
+
+    const bool bIncremental = StudioSystem[EFMODSystemContext::Auditioning] && StudioSystem[EFMODSystemContext::Editor] &&
+                              !ChangedBanks.ContainsByPredicate(IsMasterBank) && !RemovedBanks.ContainsByPredicate(IsMasterBank);
+
+    if (!bIncremental)
+    {
+        ReloadAllBanks();
+        return;
+    }
+
+    UE_LOG(LogFMOD, Verbose, TEXT("Reloading %d changed banks, unloading %d removed banks"), ChangedBanks.Num(), RemovedBanks.Num());
+
+    ReloadChangedBanks(EFMODSystemContext::Auditioning, ChangedBanks, RemovedBanks);
+    ReloadChangedBanks(EFMODSystemContext::Editor, ChangedBanks, RemovedBanks);
+    BanksReloadedDelegate.Broadcast();
+}
+
+void FFMODStudioModule::ReloadChangedBanks(EFMODSystemContext::Type Type, const TArray<FString> &ChangedBanks, const TArray<FString> &RemovedBanks)
+{
+    FMOD::Studio::System *System = StudioSystem[Type];
+    FFMODBankLoadState &LoadState = BankLoads[Type];
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+
+    if (Type == EFMODSystemContext::Auditioning)
+    {
+        StopAuditioningInstance();
+    }
+
+    // Banks are identified by GUID, so the old copy has to be unloaded before the new one can be loaded
+    for (int32 i = LoadState.Entries.Num() - 1; i >= 0; --i)
+    {
+        const NamedBankEntry &Entry = LoadState.Entries[i];
+        if (ChangedBanks.Contains(Entry.Name) || RemovedBanks.Contains(Entry.Name))
+        {
+            UE_LOG(LogFMOD, Log, TEXT("Unloading bank: %s"), *Entry.Name);
+            if (Entry.Bank && Entry.Result == FMOD_OK)
+            {
+                verifyfmod(Entry.Bank->unload());
+            }
+            if (Entry.bComplete)
+            {
+                --LoadState.CompletedCount;
+            }
+            const FString FailurePrefix = FPaths::GetBaseFilename(Entry.Name) + TEXT(" (");
+            FailedBankLoads[Type].RemoveAll([&FailurePrefix](const FString &Failure) { return Failure.StartsWith(FailurePrefix); });
+            LoadState.Entries.RemoveAt(i);
+        }
+    }
+
+    for (const FString &Path : ChangedBanks)
+    {
+        if (Settings.SkipLoadBankName.Len() && Path.Contains(Settings.SkipLoadBankName))
+        {
+            UE_LOG(LogFMOD, Log, TEXT("Skipping bank: %s"), *Path);
+            continue;
+        }
+        UE_LOG(LogFMOD, Log, TEXT("Loading bank: %s"), *Path);
+
+        QueueBankLoad(Type, Path, FMOD_STUDIO_LOAD_BANK_NONBLOCKING, nullptr);
+    }
+
+    System->flushCommands();
+    InvalidateEventDescriptions(Type);
+    UpdateBankLoads(Type);
 }
 #endif
 
@@ -1532,16 +2257,85 @@ FMOD::Studio::EventDescription *FFMODStudioModule::GetEventDescription(const UFM
     {
         Context = (bIsInPIE ? EFMODSystemContext::Runtime : EFMODSystemContext::Auditioning);
     }
+    FMOD::Studio::EventDescription *EventDesc = FindEventDescription(Event, Context);
+    if (Context == EFMODSystemContext::Runtime)
+    {
+        SampleDataManager.Touch(EventDesc);
+    }
+    return EventDesc;
+}
+
+FMOD::Studio::EventDescription *FFMODStudioModule::FindEventDescription(const UFMODEvent *Event, EFMODSystemContext::Type Context)
+{
     if (StudioSystem[Context] != nullptr && IsValid(Event) && Event->AssetGuid.IsValid())
     {
-        FMOD::Studio::ID Guid = FMODUtils::ConvertGuid(Event->AssetGuid);
+        FFMODCachedEventDescription &Cached = Event->CachedDescriptions[Context];
         FMOD::Studio::EventDescription *EventDesc = nullptr;
-        StudioSystem[Context]->getEventByID(&Guid, &EventDesc);
+        if (Cached.Generation == BankGeneration[Context])
+        {
+            EventDesc = Cached.Description;
+        }
+        else
+        {
+            FMOD::Studio::ID Guid = FMODUtils::ConvertGuid(Event->AssetGuid);
+            StudioSystem[Context]->getEventByID(&Guid, &EventDesc);
+
+            // Only cache events that were found, so they are looked up again once their bank loads
+            if (EventDesc)
+            {
+                Cached.Description = EventDesc;
+                Cached.Generation = BankGeneration[Context];
+            }
+        }
         return EventDesc;
     }
     return nullptr;
 }
 
+void FFMODStudioModule::InvalidateEventDescriptions(EFMODSystemContext::Type Context)
+{
+    // Generation 0 is never current, so it always means not cached
+    if (++BankGeneration[Context] == 0)
+    {
+        ++BankGeneration[Context];
+    }
+
+    // Components hold on to the ids they are using, so only new lookups are affected
+    ParameterIds.Reset();
+
+    // Pools of events whose banks were unloaded can't be reused
+    EventInstancePool.ReleaseInvalid();
+}
+
+TSharedPtr<const FFMODParameterIds> FFMODStudioModule::GetParameterIds(FMOD::Studio::EventDescription *EventDesc)
+{
+    if (EventDesc == nullptr)
+    {
+        return nullptr;
+    }
+
+    TSharedPtr<const FFMODParameterIds> &Ids = ParameterIds.FindOrAdd(EventDesc);
+    if (!Ids.IsValid())
+    {
+        TSharedRef<FFMODParameterIds> NewIds = MakeShared<FFMODParameterIds>();
+
+        int ParameterCount = 0;
+        verifyfmod(EventDesc->getParameterDescriptionCount(&ParameterCount));
+        NewIds->Ids.Reserve(ParameterCount);
+        for (int i = 0; i < ParameterCount; ++i)
+        {
+            FMOD_STUDIO_PARAMETER_DESCRIPTION ParameterDesc = {};
+            if (EventDesc->getParameterDescriptionByIndex(i, &ParameterDesc) == FMOD_OK)
+            {
+                NewIds->Ids.Add(FName(UTF8_TO_TCHAR(ParameterDesc.name)), ParameterDesc.id);
+            }
+        }
+
+        Ids = NewIds;
+    }
+    return Ids;
+}
+
 FMOD::Studio::EventInstance *FFMODStudioModule::CreateAuditioningInstance(const UFMODEvent *Event)
 {
     StopAuditioningInstance();
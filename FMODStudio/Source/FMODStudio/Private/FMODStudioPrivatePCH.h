@@ -5,5 +5,8 @@
 #include "UObject/NoExportTypes.h"
 #include "Components/SceneComponent.h"
 #include "Runtime/Launch/Resources/Version.h"
+#include "Stats/Stats.h"
 
-DECLARE_LOG_CATEGORY_EXTERN(LogFMOD, Log, All);
\ No newline at end of file
+DECLARE_LOG_CATEGORY_EXTERN(LogFMOD, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("FMOD"), STATGROUP_FMOD, STATCAT_Advanced);
\ No newline at end of file
@@ -3,9 +3,11 @@
 #pragma once
 
 #include "Modules/ModuleManager.h"
+#include "Templates/SharedPointer.h"
 
 namespace FMOD
 {
+class Sound;
 namespace Studio
 {
 class System;
@@ -15,9 +17,13 @@ class EventInstance;
 }
 
 class UFMODAsset;
+class UFMODAudioComponent;
 class UFMODBank;
+class UFMODBankManifest;
 class UFMODEvent;
 class UWorld;
+struct FStreamableHandle;
+struct FFMODParameterIds;
 class AAudioVolume;
 struct FInteriorSettings;
 struct FFMODListener; // Currently only for private use, we don't export this type
@@ -41,6 +47,15 @@ enum Type
 };
 }
 
+/** Delegate called as each bank queued for a system finishes loading: context, bank file path, whether it loaded and overall progress (0-1) */
+DECLARE_MULTICAST_DELEGATE_FourParams(FFMODBankLoadProgressDelegate, EFMODSystemContext::Type, const FString &, bool, float);
+
+/** Delegate called once all banks queued for a system have finished loading */
+DECLARE_MULTICAST_DELEGATE_OneParam(FFMODBanksLoadedDelegate, EFMODSystemContext::Type);
+
+/** Delegate called with the asset found by FindAssetByNameAsync, or null if there is none */
+DECLARE_DELEGATE_OneParam(FFMODAssetFoundDelegate, UFMODAsset *);
+
 /**
  * The public interface to this module
  */
@@ -87,6 +102,13 @@ public:
 	 */
     virtual UFMODEvent *FindEventByName(const FString &Name) = 0;
 
+    /**
+	 * Look up an asset given its name without blocking. The asset's package is loaded through the async loader if it
+	 * isn't already in memory. OnFound is called on the game thread with the asset, or null if there is no such asset,
+	 * immediately if no load is needed. Returns the streaming handle of the load, if one was started.
+	 */
+    virtual TSharedPtr<FStreamableHandle> FindAssetByNameAsync(const FString &Name, FFMODAssetFoundDelegate OnFound) = 0;
+
     /**
       * Get the disk path for a Bank asset
       */
@@ -104,6 +126,18 @@ public:
     virtual FMOD::Studio::EventDescription *GetEventDescription(
         const UFMODEvent *Event, EFMODSystemContext::Type Context = EFMODSystemContext::Max) = 0;
 
+    /**
+     * Discard the event descriptions cached by GetEventDescription for a system.
+     * Call this after unloading banks directly through the FMOD Studio API.
+     */
+    virtual void InvalidateEventDescriptions(EFMODSystemContext::Type Context) = 0;
+
+    /**
+     * Get the ids of an event's parameters by name, so they can be set by id. The ids are looked up once per event description
+     * and shared until its banks are unloaded.
+     */
+    virtual TSharedPtr<const FFMODParameterIds> GetParameterIds(FMOD::Studio::EventDescription *EventDesc) = 0;
+
     /**
 	 * Create a single auditioning instance using the auditioning system
 	 */
@@ -155,6 +189,100 @@ public:
     /** Returns if the banks have been loaded */
     virtual bool AreBanksLoaded() = 0;
 
+    /** Returns the fraction (0-1) of the banks queued for a system that have finished loading */
+    virtual float GetBankLoadProgress(EFMODSystemContext::Type Context) = 0;
+
+    /** Multicast delegate that is triggered as each bank queued for a system finishes loading or fails to load */
+    virtual FFMODBankLoadProgressDelegate &BankLoadProgressEvent() = 0;
+
+    /** Multicast delegate that is triggered once all banks queued for a system have finished loading */
+    virtual FFMODBanksLoadedDelegate &BanksLoadedEvent() = 0;
+
+    /** Load the banks of a manifest into the runtime system. Banks are reference counted across all acquired manifests */
+    virtual void AcquireBankManifest(const UFMODBankManifest *Manifest) = 0;
+
+    /** Release a manifest acquired with AcquireBankManifest, unloading banks no other manifest needs */
+    virtual void ReleaseBankManifest(const UFMODBankManifest *Manifest) = 0;
+
+    /**
+     * Load the sample data of an event. In the runtime system the sample data is kept within UFMODSettings::SampleDataBudget,
+     * unloading the least recently used events once the budget is exceeded.
+     */
+    virtual void LoadEventSampleData(const UFMODEvent *Event) = 0;
+
+    /** Unload sample data loaded with LoadEventSampleData */
+    virtual void UnloadEventSampleData(const UFMODEvent *Event) = 0;
+
+    /**
+     * Prefetch the sample data of an audio component's event whenever it is within UFMODSettings::SampleDataPrefetchRadius
+     * of a listener. Components register themselves when they begin play.
+     */
+    virtual void RegisterPrefetchComponent(UFMODAudioComponent *Component) = 0;
+
+    /** Stop prefetching for a component, releasing any sample data prefetched for it */
+    virtual void UnregisterPrefetchComponent(UFMODAudioComponent *Component) = 0;
+
+    /**
+     * Queue an asynchronous occlusion trace for an audio component. Traces are issued in order of audibility, at most
+     * UFMODSettings::OcclusionTracesPerFrame each frame, and their results are applied on a later tick.
+     */
+    virtual void RequestOcclusionUpdate(UFMODAudioComponent *Component) = 0;
+
+    /** Discard any pending occlusion trace for a component */
+    virtual void CancelOcclusionUpdate(UFMODAudioComponent *Component) = 0;
+
+    /**
+     * Update a playing audio component from the module tick instead of its own tick function.
+     * Components register themselves when they start playing if UFMODSettings::bUseEmitterManager is set.
+     */
+    virtual void RegisterEmitter(UFMODAudioComponent *Component) = 0;
+
+    /** Stop updating a component registered with RegisterEmitter */
+    virtual void UnregisterEmitter(UFMODAudioComponent *Component) = 0;
+
+    /**
+     * Find the audio volume containing a location and the interior settings that apply there, like UWorld::GetAudioSettings
+     * but using a spatial index of the world's audio volumes.
+     */
+    virtual AAudioVolume *FindAudioVolume(UWorld *World, const FVector &Location, const FInteriorSettings *&OutSettings) = 0;
+
+    /** Returns a value that changes whenever the audio volume index is rebuilt or a volume is enabled or disabled, invalidating earlier FindAudioVolume results */
+    virtual uint32 GetAudioVolumeGeneration() const = 0;
+
+    /** Rebuild the audio volume index, e.g. after moving an audio volume at runtime */
+    virtual void InvalidateAudioVolumes() = 0;
+
+    /**
+     * Get a stopped instance of an event, reusing a pooled one if UFMODSettings::EventInstancePoolSize is set.
+     * Hand it back with ReleaseEventInstance rather than releasing it directly.
+     */
+    virtual FMOD::Studio::EventInstance *AcquireEventInstance(FMOD::Studio::EventDescription *EventDesc) = 0;
+
+    /**
+     * Release an instance from AcquireEventInstance. It may still be playing, and is returned to the pool once it stops,
+     * so don't use it afterwards.
+     */
+    virtual void ReleaseEventInstance(FMOD::Studio::EventInstance *Instance) = 0;
+
+    /**
+     * Get the sound for a programmer sound name: an audio table key, a file path relative to the content directory, or a
+     * url. In the runtime system sounds are shared and kept within UFMODSettings::ProgrammerSoundCacheBudget once they
+     * stop, so replaying a name doesn't create its sound again. Hand it back with ReleaseProgrammerSound.
+     */
+    virtual FMOD::Sound *AcquireProgrammerSound(const FString &Name, int32 &OutSubsoundIndex) = 0;
+
+    /** Release a sound from AcquireProgrammerSound. Safe to call from FMOD callbacks */
+    virtual void ReleaseProgrammerSound(FMOD::Sound *Sound) = 0;
+
+    /**
+     * Start loading programmer sounds in the background, keeping them in the runtime system until they are unloaded.
+     * Preloaded audio table entries are dropped when the locale changes, so preload them again for the new locale.
+     */
+    virtual void PreloadProgrammerSounds(const TArray<FString> &Names) = 0;
+
+    /** Allow sounds loaded with PreloadProgrammerSounds to be released */
+    virtual void UnloadProgrammerSounds(const TArray<FString> &Names) = 0;
+
     /** Set active locale. Locale must be the locale name of one of the configured project locales */
     virtual bool SetLocale(const FString& Locale) = 0;
 
@@ -170,7 +298,11 @@ public:
 
     virtual void PreEndPIE() = 0;
 
-    /** Called by the editor module when banks have been modified on disk */
+    /** Called by the editor module when banks have been modified on disk. Changed banks are found on a worker
+     *  thread, so the reload may complete on a later tick */
     virtual void ReloadBanks() = 0;
+
+    /** Event fired when a ReloadBanks has completed */
+    virtual FSimpleMulticastDelegate &BanksReloadedEvent() = 0;
 #endif
 };
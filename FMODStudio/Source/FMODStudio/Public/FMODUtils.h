@@ -199,4 +199,12 @@ inline FString ParameterTypeToString(FMOD_STUDIO_PARAMETER_TYPE Type)
 
     return FString();
 }
-}
\ No newline at end of file
+}
+
+/** The ids of an event's parameters by name, shared by everything playing the event. See IFMODStudioModule::GetParameterIds */
+struct FFMODParameterIds
+{
+    const FMOD_STUDIO_PARAMETER_ID *Find(FName Name) const { return Ids.Find(Name); }
+
+    TMap<FName, FMOD_STUDIO_PARAMETER_ID> Ids;
+};
\ No newline at end of file
@@ -0,0 +1,23 @@
+// Copyright (c), Firelight Technologies Pty, Ltd.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "FMODReplayFileTraceCommandlet.generated.h"
+
+/**
+ * Replays an FMOD file trace recorded with -FMODFileTrace against the project's file settings, or overrides of them,
+ * and logs the resulting file statistics. e.g.
+ *   -run=FMODReplayFileTrace -trace=<path> [-realtime] [-FileBufferSize=N] [-FileThreadCount=N] [-FileCacheSize=N]
+ *   [-FileCacheBlockSize=N] [-FileReadAheadBlocks=N] [-mmap=0|1] [-asyncreadhandles=0|1]
+ */
+UCLASS()
+class UFMODReplayFileTraceCommandlet : public UCommandlet
+{
+    GENERATED_UCLASS_BODY()
+
+    //~ Begin UCommandlet Interface
+    virtual int32 Main(const FString &Params) override;
+    //~ End UCommandlet Interface
+};
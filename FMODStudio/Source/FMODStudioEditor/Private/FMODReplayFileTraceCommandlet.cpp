@@ -0,0 +1,64 @@
+// Copyright (c), Firelight Technologies Pty, Ltd.
+
+#include "FMODReplayFileTraceCommandlet.h"
+
+#include "FMODSettings.h"
+#include "FMODFileCallbacks.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogFMODCommandlet, Log, All);
+
+static constexpr auto TraceParam = TEXT("trace");
+static constexpr auto RealTimeSwitch = TEXT("realtime");
+
+UFMODReplayFileTraceCommandlet::UFMODReplayFileTraceCommandlet(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+{
+}
+
+int32 UFMODReplayFileTraceCommandlet::Main(const FString& CommandLine)
+{
+    TArray<FString> Tokens, Switches;
+    TMap<FString, FString> Params;
+    ParseCommandLine(*CommandLine, Tokens, Switches, Params);
+
+    const FString *TracePath = Params.Find(TraceParam);
+    if (!TracePath)
+    {
+        UE_LOG(LogFMODCommandlet, Error, TEXT("Usage: -run=FMODReplayFileTrace -trace=<path> [-realtime] [-<FileSetting>=<Value> ...]"));
+        return 1;
+    }
+
+    // Start from the project settings and apply any overrides
+    UFMODSettings *Settings = DuplicateObject<UFMODSettings>(GetDefault<UFMODSettings>(), GetTransientPackage());
+
+    auto OverrideInt = [&Params](const TCHAR *Name, int32 &Value) {
+        if (const FString *Param = Params.Find(Name))
+        {
+            Value = FCString::Atoi(**Param);
+        }
+    };
+    auto OverrideBool = [&Params](const TCHAR *Name, bool &Value) {
+        if (const FString *Param = Params.Find(Name))
+        {
+            Value = FCString::ToBool(**Param);
+        }
+    };
+
+    OverrideInt(TEXT("FileBufferSize"), Settings->FileBufferSize);
+    OverrideInt(TEXT("FileThreadCount"), Settings->FileThreadCount);
+    OverrideInt(TEXT("FileCacheSize"), Settings->FileCacheSize);
+    OverrideInt(TEXT("FileCacheBlockSize"), Settings->FileCacheBlockSize);
+    OverrideInt(TEXT("FileReadAheadBlocks"), Settings->FileReadAheadBlocks);
+    OverrideBool(TEXT("mmap"), Settings->bMemoryMapBankFiles);
+    OverrideBool(TEXT("asyncreadhandles"), Settings->bUseAsyncFileReadHandles);
+
+    UE_LOG(LogFMODCommandlet, Display,
+        TEXT("FileBufferSize %d, FileThreadCount %d, FileCacheSize %d, FileCacheBlockSize %d, FileReadAheadBlocks %d, mmap %d, asyncreadhandles %d"),
+        Settings->FileBufferSize, Settings->FileThreadCount, Settings->FileCacheSize, Settings->FileCacheBlockSize,
+        Settings->FileReadAheadBlocks, Settings->bMemoryMapBankFiles, Settings->bUseAsyncFileReadHandles);
+
+    bool bReplayed = ReplayFMODFileTrace(*TracePath, *Settings, Switches.Contains(RealTimeSwitch), *GLog);
+
+    return bReplayed ? 0 : 1;
+}
@@ -224,6 +224,9 @@ public:
     /** Reload banks */
     void ReloadBanks();
 
+    /** Callback for the runtime module finishing a bank reload */
+    void OnBanksReloaded();
+
     /** Callback for the main frame finishing load */
     void OnMainFrameLoaded(TSharedPtr<SWindow> InRootWindow, bool bIsNewProjectWindow);
 
@@ -362,6 +365,9 @@ void FFMODStudioEditorModule::OnPostEngineInit()
     // Create asset builder
     AssetBuilder.Create();
 
+    // Bank reloads can finish on a later tick, so notify once the runtime module reports they are done
+    IFMODStudioModule::Get().BanksReloadedEvent().AddRaw(this, &FFMODStudioEditorModule::OnBanksReloaded);
+
     if (!IsRunningCommandlet())
     {
         // Build assets when asset registry has finished loading
@@ -1172,6 +1178,11 @@ void FFMODStudioEditorModule::ShutdownModule()
     {
         BankUpdateNotifier.BanksUpdatedEvent.RemoveAll(this);
 
+        if (IFMODStudioModule::IsAvailable())
+        {
+            IFMODStudioModule::Get().BanksReloadedEvent().RemoveAll(this);
+        }
+
         // Unregister tick function.
         FTicker::GetCoreTicker().RemoveTicker(TickDelegateHandle);
 
@@ -1239,6 +1250,10 @@ void FFMODStudioEditorModule::ReloadBanks()
 {
     AssetBuilder.ProcessBanks();
     IFMODStudioModule::Get().ReloadBanks();
+}
+
+void FFMODStudioEditorModule::OnBanksReloaded()
+{
     BanksReloadedDelegate.Broadcast();
 
     // Show a reload notification